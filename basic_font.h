@@ -1,13 +1,210 @@
 #ifndef _basic_font_h
 #define _basic_font_h
-#include "font.h"
+#include <stdint.h>
 #include "font_struct.h"
 
-const font basic_font = {
-	.bytes_per_char = 5,
-	.char_width = 5,
-	.first_char_in_font = 32,
-	.char_height = 8,
-	.bitmap_buffer = (char *)&font_8x5[5],
+// generated by tools/fontconv from font_8x5
+static const uint8_t basic_font_bitmap[]= {
+	0x00,0x00,0x00,0x00,0x00, // ' '
+	0x00,0x00,0x5f,0x00,0x00, // '!'
+	0x00,0x07,0x00,0x07,0x00, // '"'
+	0x14,0x7f,0x14,0x7f,0x14, // '#'
+	0x24,0x2a,0x7f,0x2a,0x12, // '$'
+	0x23,0x13,0x08,0x64,0x62, // '%'
+	0x36,0x49,0x56,0x20,0x50, // '&'
+	0x00,0x08,0x07,0x03,0x00, // '\''
+	0x00,0x1c,0x22,0x41,0x00, // '('
+	0x00,0x41,0x22,0x1c,0x00, // ')'
+	0x2a,0x1c,0x7f,0x1c,0x2a, // '*'
+	0x08,0x08,0x3e,0x08,0x08, // '+'
+	0x00,0x80,0x70,0x30,0x00, // ','
+	0x08,0x08,0x08,0x08,0x08, // '-'
+	0x00,0x00,0x60,0x60,0x00, // '.'
+	0x20,0x10,0x08,0x04,0x02, // '/'
+	0x3e,0x51,0x49,0x45,0x3e, // '0'
+	0x00,0x42,0x7f,0x40,0x00, // '1'
+	0x72,0x49,0x49,0x49,0x46, // '2'
+	0x21,0x41,0x49,0x4d,0x33, // '3'
+	0x18,0x14,0x12,0x7f,0x10, // '4'
+	0x27,0x45,0x45,0x45,0x39, // '5'
+	0x3c,0x4a,0x49,0x49,0x31, // '6'
+	0x41,0x21,0x11,0x09,0x07, // '7'
+	0x36,0x49,0x49,0x49,0x36, // '8'
+	0x46,0x49,0x49,0x29,0x1e, // '9'
+	0x00,0x00,0x14,0x00,0x00, // ':'
+	0x00,0x40,0x34,0x00,0x00, // ';'
+	0x00,0x08,0x14,0x22,0x41, // '<'
+	0x14,0x14,0x14,0x14,0x14, // '='
+	0x00,0x41,0x22,0x14,0x08, // '>'
+	0x02,0x01,0x59,0x09,0x06, // '?'
+	0x3e,0x41,0x5d,0x59,0x4e, // '@'
+	0x7c,0x12,0x11,0x12,0x7c, // 'A'
+	0x7f,0x49,0x49,0x49,0x36, // 'B'
+	0x3e,0x41,0x41,0x41,0x22, // 'C'
+	0x7f,0x41,0x41,0x41,0x3e, // 'D'
+	0x7f,0x49,0x49,0x49,0x41, // 'E'
+	0x7f,0x09,0x09,0x09,0x01, // 'F'
+	0x3e,0x41,0x41,0x51,0x73, // 'G'
+	0x7f,0x08,0x08,0x08,0x7f, // 'H'
+	0x00,0x41,0x7f,0x41,0x00, // 'I'
+	0x20,0x40,0x41,0x3f,0x01, // 'J'
+	0x7f,0x08,0x14,0x22,0x41, // 'K'
+	0x7f,0x40,0x40,0x40,0x40, // 'L'
+	0x7f,0x02,0x1c,0x02,0x7f, // 'M'
+	0x7f,0x04,0x08,0x10,0x7f, // 'N'
+	0x3e,0x41,0x41,0x41,0x3e, // 'O'
+	0x7f,0x09,0x09,0x09,0x06, // 'P'
+	0x3e,0x41,0x51,0x21,0x5e, // 'Q'
+	0x7f,0x09,0x19,0x29,0x46, // 'R'
+	0x26,0x49,0x49,0x49,0x32, // 'S'
+	0x03,0x01,0x7f,0x01,0x03, // 'T'
+	0x3f,0x40,0x40,0x40,0x3f, // 'U'
+	0x1f,0x20,0x40,0x20,0x1f, // 'V'
+	0x3f,0x40,0x38,0x40,0x3f, // 'W'
+	0x63,0x14,0x08,0x14,0x63, // 'X'
+	0x03,0x04,0x78,0x04,0x03, // 'Y'
+	0x61,0x59,0x49,0x4d,0x43, // 'Z'
+	0x00,0x7f,0x41,0x41,0x41, // '['
+	0x02,0x04,0x08,0x10,0x20, // '\\'
+	0x00,0x41,0x41,0x41,0x7f, // ']'
+	0x04,0x02,0x01,0x02,0x04, // '^'
+	0x40,0x40,0x40,0x40,0x40, // '_'
+	0x00,0x03,0x07,0x08,0x00, // '`'
+	0x20,0x54,0x54,0x78,0x40, // 'a'
+	0x7f,0x28,0x44,0x44,0x38, // 'b'
+	0x38,0x44,0x44,0x44,0x28, // 'c'
+	0x38,0x44,0x44,0x28,0x7f, // 'd'
+	0x38,0x54,0x54,0x54,0x18, // 'e'
+	0x00,0x08,0x7e,0x09,0x02, // 'f'
+	0x18,0xa4,0xa4,0x9c,0x78, // 'g'
+	0x7f,0x08,0x04,0x04,0x78, // 'h'
+	0x00,0x44,0x7d,0x40,0x00, // 'i'
+	0x20,0x40,0x40,0x3d,0x00, // 'j'
+	0x7f,0x10,0x28,0x44,0x00, // 'k'
+	0x00,0x41,0x7f,0x40,0x00, // 'l'
+	0x7c,0x04,0x78,0x04,0x78, // 'm'
+	0x7c,0x08,0x04,0x04,0x78, // 'n'
+	0x38,0x44,0x44,0x44,0x38, // 'o'
+	0xfc,0x18,0x24,0x24,0x18, // 'p'
+	0x18,0x24,0x24,0x18,0xfc, // 'q'
+	0x7c,0x08,0x04,0x04,0x08, // 'r'
+	0x48,0x54,0x54,0x54,0x24, // 's'
+	0x04,0x04,0x3f,0x44,0x24, // 't'
+	0x3c,0x40,0x40,0x20,0x7c, // 'u'
+	0x1c,0x20,0x40,0x20,0x1c, // 'v'
+	0x3c,0x40,0x30,0x40,0x3c, // 'w'
+	0x44,0x28,0x10,0x28,0x44, // 'x'
+	0x4c,0x90,0x90,0x90,0x7c, // 'y'
+	0x44,0x64,0x54,0x4c,0x44, // 'z'
+	0x00,0x08,0x36,0x41,0x00, // '{'
+	0x00,0x00,0x77,0x00,0x00, // '|'
+	0x00,0x41,0x36,0x08,0x00, // '}'
+	0x02,0x01,0x02,0x04,0x02, // '~'
+};
+
+static const ssd1306_glyph_t basic_font_glyphs[]= {
+	{0, 5, 6}, // ' '
+	{5, 5, 6}, // '!'
+	{10, 5, 6}, // '"'
+	{15, 5, 6}, // '#'
+	{20, 5, 6}, // '$'
+	{25, 5, 6}, // '%'
+	{30, 5, 6}, // '&'
+	{35, 5, 6}, // '\''
+	{40, 5, 6}, // '('
+	{45, 5, 6}, // ')'
+	{50, 5, 6}, // '*'
+	{55, 5, 6}, // '+'
+	{60, 5, 6}, // ','
+	{65, 5, 6}, // '-'
+	{70, 5, 6}, // '.'
+	{75, 5, 6}, // '/'
+	{80, 5, 6}, // '0'
+	{85, 5, 6}, // '1'
+	{90, 5, 6}, // '2'
+	{95, 5, 6}, // '3'
+	{100, 5, 6}, // '4'
+	{105, 5, 6}, // '5'
+	{110, 5, 6}, // '6'
+	{115, 5, 6}, // '7'
+	{120, 5, 6}, // '8'
+	{125, 5, 6}, // '9'
+	{130, 5, 6}, // ':'
+	{135, 5, 6}, // ';'
+	{140, 5, 6}, // '<'
+	{145, 5, 6}, // '='
+	{150, 5, 6}, // '>'
+	{155, 5, 6}, // '?'
+	{160, 5, 6}, // '@'
+	{165, 5, 6}, // 'A'
+	{170, 5, 6}, // 'B'
+	{175, 5, 6}, // 'C'
+	{180, 5, 6}, // 'D'
+	{185, 5, 6}, // 'E'
+	{190, 5, 6}, // 'F'
+	{195, 5, 6}, // 'G'
+	{200, 5, 6}, // 'H'
+	{205, 5, 6}, // 'I'
+	{210, 5, 6}, // 'J'
+	{215, 5, 6}, // 'K'
+	{220, 5, 6}, // 'L'
+	{225, 5, 6}, // 'M'
+	{230, 5, 6}, // 'N'
+	{235, 5, 6}, // 'O'
+	{240, 5, 6}, // 'P'
+	{245, 5, 6}, // 'Q'
+	{250, 5, 6}, // 'R'
+	{255, 5, 6}, // 'S'
+	{260, 5, 6}, // 'T'
+	{265, 5, 6}, // 'U'
+	{270, 5, 6}, // 'V'
+	{275, 5, 6}, // 'W'
+	{280, 5, 6}, // 'X'
+	{285, 5, 6}, // 'Y'
+	{290, 5, 6}, // 'Z'
+	{295, 5, 6}, // '['
+	{300, 5, 6}, // '\\'
+	{305, 5, 6}, // ']'
+	{310, 5, 6}, // '^'
+	{315, 5, 6}, // '_'
+	{320, 5, 6}, // '`'
+	{325, 5, 6}, // 'a'
+	{330, 5, 6}, // 'b'
+	{335, 5, 6}, // 'c'
+	{340, 5, 6}, // 'd'
+	{345, 5, 6}, // 'e'
+	{350, 5, 6}, // 'f'
+	{355, 5, 6}, // 'g'
+	{360, 5, 6}, // 'h'
+	{365, 5, 6}, // 'i'
+	{370, 5, 6}, // 'j'
+	{375, 5, 6}, // 'k'
+	{380, 5, 6}, // 'l'
+	{385, 5, 6}, // 'm'
+	{390, 5, 6}, // 'n'
+	{395, 5, 6}, // 'o'
+	{400, 5, 6}, // 'p'
+	{405, 5, 6}, // 'q'
+	{410, 5, 6}, // 'r'
+	{415, 5, 6}, // 's'
+	{420, 5, 6}, // 't'
+	{425, 5, 6}, // 'u'
+	{430, 5, 6}, // 'v'
+	{435, 5, 6}, // 'w'
+	{440, 5, 6}, // 'x'
+	{445, 5, 6}, // 'y'
+	{450, 5, 6}, // 'z'
+	{455, 5, 6}, // '{'
+	{460, 5, 6}, // '|'
+	{465, 5, 6}, // '}'
+	{470, 5, 6}, // '~'
+};
+
+const ssd1306_font_t basic_font= {
+	.height=8,
+	.first=32,
+	.last=126,
+	.glyphs=basic_font_glyphs,
+	.bitmap=basic_font_bitmap,
 };
 #endif
@@ -1,113 +1,205 @@
-#ifndef _bmspa_font_h
-#define _bmspa_font_h
-#include <stdint.h>
-#include "font_struct.h"
-
-const uint8_t BMSPA_font[] = {
-	8, 8, 0, 32, 126,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, //  
-	0x00,0x5f,0x00,0x00,0x00,0x00,0x00,0x00, // !
-	0x00,0x03,0x00,0x03,0x00,0x00,0x00,0x00, // "
-	0x0a,0x1f,0x0a,0x1f,0x0a,0x00,0x00,0x00, // #
-	0x24,0x2a,0x2a,0x7f,0x2a,0x2a,0x12,0x00, // $
-	0x00,0x47,0x25,0x17,0x08,0x74,0x52,0x71, // %
-	0x00,0x36,0x49,0x49,0x49,0x41,0x41,0x38, // &
-	0x00,0x03,0x00,0x00,0x00,0x00,0x00,0x00, // '
-	0x00,0x3e,0x41,0x00,0x00,0x00,0x00,0x00, // (
-	0x41,0x3e,0x00,0x00,0x00,0x00,0x00,0x00, // )
-	0x04,0x15,0x0e,0x15,0x04,0x00,0x00,0x00, // *
-	0x08,0x08,0x3e,0x08,0x08,0x00,0x00,0x00, // +
-	0x00,0xc0,0x00,0x00,0x00,0x00,0x00,0x00, // ,
-	0x08,0x08,0x08,0x08,0x08,0x00,0x00,0x00, // -
-	0x40,0x00,0x00,0x00,0x00,0x00,0x00,0x00, // .
-	0x40,0x20,0x10,0x08,0x04,0x02,0x01,0x00, // /
-	0x00,0x3e,0x61,0x51,0x49,0x45,0x43,0x3e, // 0
-	0x01,0x01,0x7e,0x00,0x00,0x00,0x00,0x00, // 1
-	0x00,0x71,0x49,0x49,0x49,0x49,0x49,0x46, // 2
-	0x41,0x49,0x49,0x49,0x49,0x49,0x36,0x00, // 3
-	0x00,0x0f,0x10,0x10,0x10,0x10,0x10,0x7f, // 4
-	0x00,0x4f,0x49,0x49,0x49,0x49,0x49,0x31, // 5
-	0x00,0x3e,0x49,0x49,0x49,0x49,0x49,0x30, // 6
-	0x01,0x01,0x01,0x01,0x01,0x01,0x7e,0x00, // 7
-	0x00,0x36,0x49,0x49,0x49,0x49,0x49,0x36, // 8
-	0x00,0x06,0x49,0x49,0x49,0x49,0x49,0x3e, // 9
-	0x14,0x00,0x00,0x00,0x00,0x00,0x00,0x00, // :
-	0x40,0x34,0x00,0x00,0x00,0x00,0x00,0x00, // ;
-	0x08,0x14,0x22,0x00,0x00,0x00,0x00,0x00, // <
-	0x14,0x14,0x14,0x14,0x14,0x00,0x00,0x00, // =
-	0x22,0x14,0x08,0x00,0x00,0x00,0x00,0x00, // >
-	0x00,0x06,0x01,0x01,0x59,0x09,0x09,0x06, // ?
-	0x00,0x3e,0x41,0x5d,0x55,0x5d,0x51,0x5e, // @
-	0x00,0x7e,0x01,0x09,0x09,0x09,0x09,0x7e, // A
-	0x00,0x7f,0x41,0x49,0x49,0x49,0x49,0x36, // B
-	0x00,0x3e,0x41,0x41,0x41,0x41,0x41,0x22, // C
-	0x00,0x7f,0x41,0x41,0x41,0x41,0x41,0x3e, // D
-	0x00,0x3e,0x49,0x49,0x49,0x49,0x49,0x41, // E
-	0x00,0x7e,0x09,0x09,0x09,0x09,0x09,0x01, // F
-	0x00,0x3e,0x41,0x49,0x49,0x49,0x49,0x79, // G
-	0x00,0x7f,0x08,0x08,0x08,0x08,0x08,0x7f, // H
-	0x00,0x7f,0x00,0x00,0x00,0x00,0x00,0x00, // I
-	0x00,0x38,0x40,0x40,0x41,0x41,0x41,0x3f, // J
-	0x00,0x7f,0x08,0x08,0x08,0x0c,0x0a,0x71, // K
-	0x00,0x3f,0x40,0x40,0x40,0x40,0x40,0x40, // L
-	0x00,0x7e,0x01,0x01,0x7e,0x01,0x01,0x7e, // M
-	0x00,0x7e,0x01,0x01,0x3e,0x40,0x40,0x3f, // N
-	0x00,0x3e,0x41,0x41,0x41,0x41,0x41,0x3e, // O
-	0x00,0x7e,0x09,0x09,0x09,0x09,0x09,0x06, // P
-	0x00,0x3e,0x41,0x41,0x71,0x51,0x51,0x7e, // Q
-	0x00,0x7e,0x01,0x31,0x49,0x49,0x49,0x46, // R
-	0x00,0x46,0x49,0x49,0x49,0x49,0x49,0x31, // S
-	0x01,0x01,0x01,0x7f,0x01,0x01,0x01,0x00, // T
-	0x00,0x3f,0x40,0x40,0x40,0x40,0x40,0x3f, // U
-	0x00,0x0f,0x10,0x20,0x40,0x20,0x10,0x0f, // V
-	0x00,0x3f,0x40,0x40,0x3f,0x40,0x40,0x3f, // W
-	0x00,0x63,0x14,0x08,0x08,0x08,0x14,0x63, // X
-	0x00,0x07,0x08,0x08,0x78,0x08,0x08,0x07, // Y
-	0x00,0x71,0x49,0x49,0x49,0x49,0x49,0x47, // Z
-	0x00,0x7f,0x41,0x00,0x00,0x00,0x00,0x00, // [
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, // "\"
-	0x41,0x7f,0x00,0x00,0x00,0x00,0x00,0x00, // ]
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, // ^
-	0x40,0x40,0x40,0x40,0x40,0x40,0x40,0x00, // _
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, // `
-	0x00,0x7e,0x01,0x09,0x09,0x09,0x09,0x7e, // A
-	0x00,0x7f,0x41,0x49,0x49,0x49,0x49,0x36, // B
-	0x00,0x3e,0x41,0x41,0x41,0x41,0x41,0x22, // C
-	0x00,0x7f,0x41,0x41,0x41,0x41,0x41,0x3e, // D
-	0x00,0x3e,0x49,0x49,0x49,0x49,0x49,0x41, // E
-	0x00,0x7e,0x09,0x09,0x09,0x09,0x09,0x01, // F
-	0x00,0x3e,0x41,0x49,0x49,0x49,0x49,0x79, // G
-	0x00,0x7f,0x08,0x08,0x08,0x08,0x08,0x7f, // H
-	0x00,0x7f,0x00,0x00,0x00,0x00,0x00,0x00, // I
-	0x00,0x38,0x40,0x40,0x41,0x41,0x41,0x3f, // J
-	0x00,0x7f,0x08,0x08,0x08,0x0c,0x0a,0x71, // K
-	0x00,0x3f,0x40,0x40,0x40,0x40,0x40,0x40, // L
-	0x00,0x7e,0x01,0x01,0x7e,0x01,0x01,0x7e, // M
-	0x00,0x7e,0x01,0x01,0x3e,0x40,0x40,0x3f, // N
-	0x00,0x3e,0x41,0x41,0x41,0x41,0x41,0x3e, // O
-	0x00,0x7e,0x09,0x09,0x09,0x09,0x09,0x06, // P
-	0x00,0x3e,0x41,0x41,0x71,0x51,0x51,0x7e, // Q
-	0x00,0x7e,0x01,0x31,0x49,0x49,0x49,0x46, // R
-	0x00,0x46,0x49,0x49,0x49,0x49,0x49,0x31, // S
-	0x01,0x01,0x01,0x7f,0x01,0x01,0x01,0x00, // T
-	0x00,0x3f,0x40,0x40,0x40,0x40,0x40,0x3f, // U
-	0x00,0x0f,0x10,0x20,0x40,0x20,0x10,0x0f, // V
-	0x00,0x3f,0x40,0x40,0x3f,0x40,0x40,0x3f, // W
-	0x00,0x63,0x14,0x08,0x08,0x08,0x14,0x63, // X
-	0x00,0x07,0x08,0x08,0x78,0x08,0x08,0x07, // Y
-	0x00,0x71,0x49,0x49,0x49,0x49,0x49,0x47, // Z
-	0x08,0x36,0x41,0x00,0x00,0x00,0x00,0x00, // {
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, // |
-	0x41,0x36,0x08,0x00,0x00,0x00,0x00,0x00, // }
-	0x02,0x01,0x01,0x02,0x02,0x01,0x00,0x00, // ~
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00
-};
-
-const font bmspa = {
-	.bitmap_buffer =  (const char *)&BMSPA_font[5] ,
-	.first_char_in_font = 32,
-	.bytes_per_char = 8,
-	.char_width = 8,
-	.char_height = 8,
-};
-#endif
+#ifndef _BMSPA_font_h
+#define _BMSPA_font_h
+#include <stdint.h>
+#include "font_struct.h"
+
+// generated by tools/fontconv -p from BMSPA_font
+static const uint8_t BMSPA_font_bitmap[]= {
+	0x5f, // '!'
+	0x03,0x00,0x03, // '"'
+	0x0a,0x1f,0x0a,0x1f,0x0a, // '#'
+	0x24,0x2a,0x2a,0x7f,0x2a,0x2a,0x12, // '$'
+	0x47,0x25,0x17,0x08,0x74,0x52,0x71, // '%'
+	0x36,0x49,0x49,0x49,0x41,0x41,0x38, // '&'
+	0x03, // '\''
+	0x3e,0x41, // '('
+	0x41,0x3e, // ')'
+	0x04,0x15,0x0e,0x15,0x04, // '*'
+	0x08,0x08,0x3e,0x08,0x08, // '+'
+	0xc0, // ','
+	0x08,0x08,0x08,0x08,0x08, // '-'
+	0x40, // '.'
+	0x40,0x20,0x10,0x08,0x04,0x02,0x01, // '/'
+	0x3e,0x61,0x51,0x49,0x45,0x43,0x3e, // '0'
+	0x01,0x01,0x7e, // '1'
+	0x71,0x49,0x49,0x49,0x49,0x49,0x46, // '2'
+	0x41,0x49,0x49,0x49,0x49,0x49,0x36, // '3'
+	0x0f,0x10,0x10,0x10,0x10,0x10,0x7f, // '4'
+	0x4f,0x49,0x49,0x49,0x49,0x49,0x31, // '5'
+	0x3e,0x49,0x49,0x49,0x49,0x49,0x30, // '6'
+	0x01,0x01,0x01,0x01,0x01,0x01,0x7e, // '7'
+	0x36,0x49,0x49,0x49,0x49,0x49,0x36, // '8'
+	0x06,0x49,0x49,0x49,0x49,0x49,0x3e, // '9'
+	0x14, // ':'
+	0x40,0x34, // ';'
+	0x08,0x14,0x22, // '<'
+	0x14,0x14,0x14,0x14,0x14, // '='
+	0x22,0x14,0x08, // '>'
+	0x06,0x01,0x01,0x59,0x09,0x09,0x06, // '?'
+	0x3e,0x41,0x5d,0x55,0x5d,0x51,0x5e, // '@'
+	0x7e,0x01,0x09,0x09,0x09,0x09,0x7e, // 'A'
+	0x7f,0x41,0x49,0x49,0x49,0x49,0x36, // 'B'
+	0x3e,0x41,0x41,0x41,0x41,0x41,0x22, // 'C'
+	0x7f,0x41,0x41,0x41,0x41,0x41,0x3e, // 'D'
+	0x3e,0x49,0x49,0x49,0x49,0x49,0x41, // 'E'
+	0x7e,0x09,0x09,0x09,0x09,0x09,0x01, // 'F'
+	0x3e,0x41,0x49,0x49,0x49,0x49,0x79, // 'G'
+	0x7f,0x08,0x08,0x08,0x08,0x08,0x7f, // 'H'
+	0x7f, // 'I'
+	0x38,0x40,0x40,0x41,0x41,0x41,0x3f, // 'J'
+	0x7f,0x08,0x08,0x08,0x0c,0x0a,0x71, // 'K'
+	0x3f,0x40,0x40,0x40,0x40,0x40,0x40, // 'L'
+	0x7e,0x01,0x01,0x7e,0x01,0x01,0x7e, // 'M'
+	0x7e,0x01,0x01,0x3e,0x40,0x40,0x3f, // 'N'
+	0x3e,0x41,0x41,0x41,0x41,0x41,0x3e, // 'O'
+	0x7e,0x09,0x09,0x09,0x09,0x09,0x06, // 'P'
+	0x3e,0x41,0x41,0x71,0x51,0x51,0x7e, // 'Q'
+	0x7e,0x01,0x31,0x49,0x49,0x49,0x46, // 'R'
+	0x46,0x49,0x49,0x49,0x49,0x49,0x31, // 'S'
+	0x01,0x01,0x01,0x7f,0x01,0x01,0x01, // 'T'
+	0x3f,0x40,0x40,0x40,0x40,0x40,0x3f, // 'U'
+	0x0f,0x10,0x20,0x40,0x20,0x10,0x0f, // 'V'
+	0x3f,0x40,0x40,0x3f,0x40,0x40,0x3f, // 'W'
+	0x63,0x14,0x08,0x08,0x08,0x14,0x63, // 'X'
+	0x07,0x08,0x08,0x78,0x08,0x08,0x07, // 'Y'
+	0x71,0x49,0x49,0x49,0x49,0x49,0x47, // 'Z'
+	0x7f,0x41, // '['
+	0x41,0x7f, // ']'
+	0x40,0x40,0x40,0x40,0x40,0x40,0x40, // '_'
+	0x7e,0x01,0x09,0x09,0x09,0x09,0x7e, // 'a'
+	0x7f,0x41,0x49,0x49,0x49,0x49,0x36, // 'b'
+	0x3e,0x41,0x41,0x41,0x41,0x41,0x22, // 'c'
+	0x7f,0x41,0x41,0x41,0x41,0x41,0x3e, // 'd'
+	0x3e,0x49,0x49,0x49,0x49,0x49,0x41, // 'e'
+	0x7e,0x09,0x09,0x09,0x09,0x09,0x01, // 'f'
+	0x3e,0x41,0x49,0x49,0x49,0x49,0x79, // 'g'
+	0x7f,0x08,0x08,0x08,0x08,0x08,0x7f, // 'h'
+	0x7f, // 'i'
+	0x38,0x40,0x40,0x41,0x41,0x41,0x3f, // 'j'
+	0x7f,0x08,0x08,0x08,0x0c,0x0a,0x71, // 'k'
+	0x3f,0x40,0x40,0x40,0x40,0x40,0x40, // 'l'
+	0x7e,0x01,0x01,0x7e,0x01,0x01,0x7e, // 'm'
+	0x7e,0x01,0x01,0x3e,0x40,0x40,0x3f, // 'n'
+	0x3e,0x41,0x41,0x41,0x41,0x41,0x3e, // 'o'
+	0x7e,0x09,0x09,0x09,0x09,0x09,0x06, // 'p'
+	0x3e,0x41,0x41,0x71,0x51,0x51,0x7e, // 'q'
+	0x7e,0x01,0x31,0x49,0x49,0x49,0x46, // 'r'
+	0x46,0x49,0x49,0x49,0x49,0x49,0x31, // 's'
+	0x01,0x01,0x01,0x7f,0x01,0x01,0x01, // 't'
+	0x3f,0x40,0x40,0x40,0x40,0x40,0x3f, // 'u'
+	0x0f,0x10,0x20,0x40,0x20,0x10,0x0f, // 'v'
+	0x3f,0x40,0x40,0x3f,0x40,0x40,0x3f, // 'w'
+	0x63,0x14,0x08,0x08,0x08,0x14,0x63, // 'x'
+	0x07,0x08,0x08,0x78,0x08,0x08,0x07, // 'y'
+	0x71,0x49,0x49,0x49,0x49,0x49,0x47, // 'z'
+	0x08,0x36,0x41, // '{'
+	0x41,0x36,0x08, // '}'
+	0x02,0x01,0x01,0x02,0x02,0x01, // '~'
+};
+
+static const ssd1306_glyph_t BMSPA_font_glyphs[]= {
+	{0, 0, 4}, // ' '
+	{0, 1, 1}, // '!'
+	{1, 3, 3}, // '"'
+	{4, 5, 5}, // '#'
+	{9, 7, 7}, // '$'
+	{16, 7, 7}, // '%'
+	{23, 7, 7}, // '&'
+	{30, 1, 1}, // '\''
+	{31, 2, 2}, // '('
+	{33, 2, 2}, // ')'
+	{35, 5, 5}, // '*'
+	{40, 5, 5}, // '+'
+	{45, 1, 1}, // ','
+	{46, 5, 5}, // '-'
+	{51, 1, 1}, // '.'
+	{52, 7, 7}, // '/'
+	{59, 7, 7}, // '0'
+	{66, 3, 3}, // '1'
+	{69, 7, 7}, // '2'
+	{76, 7, 7}, // '3'
+	{83, 7, 7}, // '4'
+	{90, 7, 7}, // '5'
+	{97, 7, 7}, // '6'
+	{104, 7, 7}, // '7'
+	{111, 7, 7}, // '8'
+	{118, 7, 7}, // '9'
+	{125, 1, 1}, // ':'
+	{126, 2, 2}, // ';'
+	{128, 3, 3}, // '<'
+	{131, 5, 5}, // '='
+	{136, 3, 3}, // '>'
+	{139, 7, 7}, // '?'
+	{146, 7, 7}, // '@'
+	{153, 7, 7}, // 'A'
+	{160, 7, 7}, // 'B'
+	{167, 7, 7}, // 'C'
+	{174, 7, 7}, // 'D'
+	{181, 7, 7}, // 'E'
+	{188, 7, 7}, // 'F'
+	{195, 7, 7}, // 'G'
+	{202, 7, 7}, // 'H'
+	{209, 1, 1}, // 'I'
+	{210, 7, 7}, // 'J'
+	{217, 7, 7}, // 'K'
+	{224, 7, 7}, // 'L'
+	{231, 7, 7}, // 'M'
+	{238, 7, 7}, // 'N'
+	{245, 7, 7}, // 'O'
+	{252, 7, 7}, // 'P'
+	{259, 7, 7}, // 'Q'
+	{266, 7, 7}, // 'R'
+	{273, 7, 7}, // 'S'
+	{280, 7, 7}, // 'T'
+	{287, 7, 7}, // 'U'
+	{294, 7, 7}, // 'V'
+	{301, 7, 7}, // 'W'
+	{308, 7, 7}, // 'X'
+	{315, 7, 7}, // 'Y'
+	{322, 7, 7}, // 'Z'
+	{329, 2, 2}, // '['
+	{331, 0, 4}, // '\\'
+	{331, 2, 2}, // ']'
+	{333, 0, 4}, // '^'
+	{333, 7, 7}, // '_'
+	{340, 0, 4}, // '`'
+	{340, 7, 7}, // 'a'
+	{347, 7, 7}, // 'b'
+	{354, 7, 7}, // 'c'
+	{361, 7, 7}, // 'd'
+	{368, 7, 7}, // 'e'
+	{375, 7, 7}, // 'f'
+	{382, 7, 7}, // 'g'
+	{389, 7, 7}, // 'h'
+	{396, 1, 1}, // 'i'
+	{397, 7, 7}, // 'j'
+	{404, 7, 7}, // 'k'
+	{411, 7, 7}, // 'l'
+	{418, 7, 7}, // 'm'
+	{425, 7, 7}, // 'n'
+	{432, 7, 7}, // 'o'
+	{439, 7, 7}, // 'p'
+	{446, 7, 7}, // 'q'
+	{453, 7, 7}, // 'r'
+	{460, 7, 7}, // 's'
+	{467, 7, 7}, // 't'
+	{474, 7, 7}, // 'u'
+	{481, 7, 7}, // 'v'
+	{488, 7, 7}, // 'w'
+	{495, 7, 7}, // 'x'
+	{502, 7, 7}, // 'y'
+	{509, 7, 7}, // 'z'
+	{516, 3, 3}, // '{'
+	{519, 0, 4}, // '|'
+	{519, 3, 3}, // '}'
+	{522, 6, 6}, // '~'
+};
+
+const ssd1306_font_t BMSPA_font= {
+	.height=8,
+	.first=32,
+	.last=126,
+	.glyphs=BMSPA_font_glyphs,
+	.bitmap=BMSPA_font_bitmap,
+};
+#endif
@@ -1,113 +1,209 @@
-#ifndef _acme_font_h
-#define _acme_font_h
-#include <stdint.h>
-#include "font_struct.h"
-
-const uint8_t acme_font[] = {
-	8, 6, 1, 32, 126,
-	0x00,0x00,0x00,0x00,0x00,0x00, //  
-	0x7f,0x51,0x7f,0x00,0x00,0x00, // !
-	0x0f,0x09,0x0f,0x09,0x0f,0x00, // "
-	0x3e,0x6b,0x41,0x6b,0x41,0x6b, // #
-	0x7f,0xd1,0x94,0xc5,0x7f,0x00, // $
-	0x77,0x4d,0x77,0x59,0x77,0x00, // %
-	0x7f,0x49,0x55,0x49,0x6f,0x54, // &
-	0x0f,0x09,0x0f,0x00,0x00,0x00, // '
-	0x7f,0xc1,0xbe,0xe3,0x00,0x00, // (
-	0xe3,0xbe,0xc1,0x7f,0x00,0x00, // )
-	0x3e,0x2a,0x77,0x41,0x77,0x2a, // *
-	0x1c,0x14,0x77,0x41,0x77,0x14, // +
-	0xe0,0xb0,0xd0,0x70,0x00,0x00, // ,
-	0x1c,0x14,0x14,0x14,0x1c,0x00, // -
-	0x70,0x50,0x70,0x00,0x00,0x00, // .
-	0x78,0x4c,0x77,0x19,0x0f,0x00, // /
-	0x7f,0x41,0x5d,0x41,0x7f,0x00, // 0
-	0x7f,0x41,0x7f,0x00,0x00,0x00, // 1
-	0x7f,0x45,0x55,0x51,0x7f,0x00, // 2
-	0x7f,0x55,0x55,0x41,0x7f,0x00, // 3
-	0x1f,0x11,0x77,0x41,0x7f,0x00, // 4
-	0x7f,0x51,0x55,0x45,0x7f,0x00, // 5
-	0x7f,0x41,0x55,0x45,0x7f,0x00, // 6
-	0x07,0x7d,0x45,0x79,0x0f,0x00, // 7
-	0x7f,0x49,0x55,0x49,0x7f,0x00, // 8
-	0x7f,0x51,0x55,0x41,0x7f,0x00, // 9
-	0x3e,0x2a,0x3e,0x00,0x00,0x00, // :
-	0xe0,0xbe,0xda,0x7e,0x00,0x00, // ;
-	0x1c,0x36,0x6b,0x5d,0x77,0x00, // <
-	0x3e,0x2a,0x2a,0x2a,0x2a,0x3e, // =
-	0x77,0x5d,0x6b,0x36,0x1c,0x00, // >
-	0x07,0x7d,0x55,0x71,0x1f,0x00, // ?
-	0x7f,0x41,0x5d,0x55,0x51,0x7f, // @
-	0x7f,0x41,0x75,0x41,0x7f,0x00, // A
-	0x7f,0x41,0x55,0x41,0x7f,0x00, // B
-	0x7f,0x41,0x5d,0x55,0x77,0x00, // C
-	0x7f,0x41,0x5d,0x63,0x3e,0x00, // D
-	0x7f,0x41,0x55,0x55,0x7f,0x00, // E
-	0x7f,0x41,0x75,0x15,0x1f,0x00, // F
-	0x7f,0x41,0x5d,0x45,0x7f,0x00, // G
-	0x7f,0x41,0x77,0x41,0x7f,0x00, // H
-	0x7f,0x41,0x7f,0x00,0x00,0x00, // I
-	0x78,0x48,0x5f,0x41,0x7f,0x00, // J
-	0x7f,0x41,0x77,0x49,0x7f,0x00, // K
-	0x7f,0x41,0x5f,0x50,0x70,0x00, // L
-	0x7f,0x41,0x3b,0x3b,0x41,0x7f, // M
-	0x7f,0x41,0x3b,0x76,0x41,0x7f, // N
-	0x7f,0x41,0x5d,0x41,0x7f,0x00, // O
-	0x7f,0x41,0x75,0x11,0x1f,0x00, // P
-	0x7f,0x41,0x1d,0x41,0x7f,0x00, // Q
-	0x7f,0x41,0x6d,0x51,0x6f,0x00, // R
-	0x7f,0x51,0x55,0x45,0x7f,0x00, // S
-	0x07,0x7d,0x41,0x7d,0x07,0x00, // T
-	0x7f,0x41,0x5f,0x41,0x7f,0x00, // U
-	0x3f,0x61,0x5f,0x61,0x3f,0x00, // V
-	0x7f,0x41,0x6e,0x6e,0x41,0x7f, // W
-	0x7f,0x49,0x77,0x49,0x7f,0x00, // X
-	0x1f,0x71,0x47,0x71,0x1f,0x00, // Y
-	0x7b,0x4d,0x55,0x59,0x6f,0x00, // Z
-	0xff,0x80,0xbe,0xe3,0x00,0x00, // [
-	0x0f,0x19,0x77,0x4c,0x78,0x00, // "\"
-	0xe3,0xbe,0x80,0xff,0x00,0x00, // ]
-	0x0e,0x0b,0x0d,0x0b,0x0e,0x00, // ^
-	0xe0,0xa0,0xa0,0xa0,0xa0,0xe0, // _
-	0x07,0x0d,0x0b,0x0e,0x00,0x00, // `
-	0x7f,0x41,0x75,0x41,0x7f,0x00, // a
-	0x7f,0x41,0x55,0x41,0x7f,0x00, // b
-	0x7f,0x41,0x5d,0x55,0x77,0x00, // c
-	0x7f,0x41,0x5d,0x63,0x3e,0x00, // d
-	0x7f,0x41,0x55,0x55,0x7f,0x00, // e
-	0x7f,0x41,0x75,0x15,0x1f,0x00, // f
-	0x7f,0x41,0x5d,0x45,0x7f,0x00, // g
-	0x7f,0x41,0x77,0x41,0x7f,0x00, // h
-	0x7f,0x41,0x7f,0x00,0x00,0x00, // i
-	0x78,0x48,0x5f,0x41,0x7f,0x00, // j
-	0x7f,0x41,0x77,0x49,0x7f,0x00, // k
-	0x7f,0x41,0x5f,0x50,0x70,0x00, // l
-	0x7f,0x41,0x3b,0x3b,0x41,0x7f, // m
-	0x7f,0x41,0x3b,0x76,0x41,0x7f, // n
-	0x7f,0x41,0x5d,0x41,0x7f,0x00, // o
-	0x7f,0x41,0x75,0x11,0x1f,0x00, // p
-	0x7f,0x41,0x1d,0x41,0x7f,0x00, // q
-	0x7f,0x41,0x6d,0x51,0x6f,0x00, // r
-	0x7f,0x51,0x55,0x45,0x7f,0x00, // s
-	0x07,0x7d,0x41,0x7d,0x07,0x00, // t
-	0x7f,0x41,0x5f,0x41,0x7f,0x00, // u
-	0x3f,0x61,0x5f,0x61,0x3f,0x00, // v
-	0x7f,0x41,0x6e,0x6e,0x41,0x7f, // w
-	0x7f,0x49,0x77,0x49,0x7f,0x00, // x
-	0x1f,0x71,0x47,0x71,0x1f,0x00, // y
-	0x7b,0x4d,0x55,0x59,0x6f,0x00, // z
-	0x1c,0xf7,0x88,0xbe,0xe3,0x00, // {
-	0xff,0x80,0xff,0x00,0x00,0x00, // |
-	0xe3,0xbe,0x88,0xf7,0x1c,0x00, // }
-	0x0f,0x09,0x0d,0x09,0x0b,0x09, // ~
-	0x00,0x00,0x00,0x00,0x00,0x00
-};
-
-const font acme = {
-	.bitmap_buffer =  (const char *)&acme_font[5] ,
-	.first_char_in_font = 32,
-	.bytes_per_char = 6,
-	.char_width = 6,
-	.char_height = 8,
-};
-#endif
+#ifndef _acme_font_h
+#define _acme_font_h
+#include <stdint.h>
+#include "font_struct.h"
+
+// generated by tools/fontconv -p from acme_font
+static const uint8_t acme_font_bitmap[]= {
+	0x7f,0x51,0x7f, // '!'
+	0x0f,0x09,0x0f,0x09,0x0f, // '"'
+	0x3e,0x6b,0x41,0x6b,0x41,0x6b, // '#'
+	0x7f,0xd1,0x94,0xc5,0x7f, // '$'
+	0x77,0x4d,0x77,0x59,0x77, // '%'
+	0x7f,0x49,0x55,0x49,0x6f,0x54, // '&'
+	0x0f,0x09,0x0f, // '\''
+	0x7f,0xc1,0xbe,0xe3, // '('
+	0xe3,0xbe,0xc1,0x7f, // ')'
+	0x3e,0x2a,0x77,0x41,0x77,0x2a, // '*'
+	0x1c,0x14,0x77,0x41,0x77,0x14, // '+'
+	0xe0,0xb0,0xd0,0x70, // ','
+	0x1c,0x14,0x14,0x14,0x1c, // '-'
+	0x70,0x50,0x70, // '.'
+	0x78,0x4c,0x77,0x19,0x0f, // '/'
+	0x7f,0x41,0x5d,0x41,0x7f, // '0'
+	0x7f,0x41,0x7f, // '1'
+	0x7f,0x45,0x55,0x51,0x7f, // '2'
+	0x7f,0x55,0x55,0x41,0x7f, // '3'
+	0x1f,0x11,0x77,0x41,0x7f, // '4'
+	0x7f,0x51,0x55,0x45,0x7f, // '5'
+	0x7f,0x41,0x55,0x45,0x7f, // '6'
+	0x07,0x7d,0x45,0x79,0x0f, // '7'
+	0x7f,0x49,0x55,0x49,0x7f, // '8'
+	0x7f,0x51,0x55,0x41,0x7f, // '9'
+	0x3e,0x2a,0x3e, // ':'
+	0xe0,0xbe,0xda,0x7e, // ';'
+	0x1c,0x36,0x6b,0x5d,0x77, // '<'
+	0x3e,0x2a,0x2a,0x2a,0x2a,0x3e, // '='
+	0x77,0x5d,0x6b,0x36,0x1c, // '>'
+	0x07,0x7d,0x55,0x71,0x1f, // '?'
+	0x7f,0x41,0x5d,0x55,0x51,0x7f, // '@'
+	0x7f,0x41,0x75,0x41,0x7f, // 'A'
+	0x7f,0x41,0x55,0x41,0x7f, // 'B'
+	0x7f,0x41,0x5d,0x55,0x77, // 'C'
+	0x7f,0x41,0x5d,0x63,0x3e, // 'D'
+	0x7f,0x41,0x55,0x55,0x7f, // 'E'
+	0x7f,0x41,0x75,0x15,0x1f, // 'F'
+	0x7f,0x41,0x5d,0x45,0x7f, // 'G'
+	0x7f,0x41,0x77,0x41,0x7f, // 'H'
+	0x7f,0x41,0x7f, // 'I'
+	0x78,0x48,0x5f,0x41,0x7f, // 'J'
+	0x7f,0x41,0x77,0x49,0x7f, // 'K'
+	0x7f,0x41,0x5f,0x50,0x70, // 'L'
+	0x7f,0x41,0x3b,0x3b,0x41,0x7f, // 'M'
+	0x7f,0x41,0x3b,0x76,0x41,0x7f, // 'N'
+	0x7f,0x41,0x5d,0x41,0x7f, // 'O'
+	0x7f,0x41,0x75,0x11,0x1f, // 'P'
+	0x7f,0x41,0x1d,0x41,0x7f, // 'Q'
+	0x7f,0x41,0x6d,0x51,0x6f, // 'R'
+	0x7f,0x51,0x55,0x45,0x7f, // 'S'
+	0x07,0x7d,0x41,0x7d,0x07, // 'T'
+	0x7f,0x41,0x5f,0x41,0x7f, // 'U'
+	0x3f,0x61,0x5f,0x61,0x3f, // 'V'
+	0x7f,0x41,0x6e,0x6e,0x41,0x7f, // 'W'
+	0x7f,0x49,0x77,0x49,0x7f, // 'X'
+	0x1f,0x71,0x47,0x71,0x1f, // 'Y'
+	0x7b,0x4d,0x55,0x59,0x6f, // 'Z'
+	0xff,0x80,0xbe,0xe3, // '['
+	0x0f,0x19,0x77,0x4c,0x78, // '\\'
+	0xe3,0xbe,0x80,0xff, // ']'
+	0x0e,0x0b,0x0d,0x0b,0x0e, // '^'
+	0xe0,0xa0,0xa0,0xa0,0xa0,0xe0, // '_'
+	0x07,0x0d,0x0b,0x0e, // '`'
+	0x7f,0x41,0x75,0x41,0x7f, // 'a'
+	0x7f,0x41,0x55,0x41,0x7f, // 'b'
+	0x7f,0x41,0x5d,0x55,0x77, // 'c'
+	0x7f,0x41,0x5d,0x63,0x3e, // 'd'
+	0x7f,0x41,0x55,0x55,0x7f, // 'e'
+	0x7f,0x41,0x75,0x15,0x1f, // 'f'
+	0x7f,0x41,0x5d,0x45,0x7f, // 'g'
+	0x7f,0x41,0x77,0x41,0x7f, // 'h'
+	0x7f,0x41,0x7f, // 'i'
+	0x78,0x48,0x5f,0x41,0x7f, // 'j'
+	0x7f,0x41,0x77,0x49,0x7f, // 'k'
+	0x7f,0x41,0x5f,0x50,0x70, // 'l'
+	0x7f,0x41,0x3b,0x3b,0x41,0x7f, // 'm'
+	0x7f,0x41,0x3b,0x76,0x41,0x7f, // 'n'
+	0x7f,0x41,0x5d,0x41,0x7f, // 'o'
+	0x7f,0x41,0x75,0x11,0x1f, // 'p'
+	0x7f,0x41,0x1d,0x41,0x7f, // 'q'
+	0x7f,0x41,0x6d,0x51,0x6f, // 'r'
+	0x7f,0x51,0x55,0x45,0x7f, // 's'
+	0x07,0x7d,0x41,0x7d,0x07, // 't'
+	0x7f,0x41,0x5f,0x41,0x7f, // 'u'
+	0x3f,0x61,0x5f,0x61,0x3f, // 'v'
+	0x7f,0x41,0x6e,0x6e,0x41,0x7f, // 'w'
+	0x7f,0x49,0x77,0x49,0x7f, // 'x'
+	0x1f,0x71,0x47,0x71,0x1f, // 'y'
+	0x7b,0x4d,0x55,0x59,0x6f, // 'z'
+	0x1c,0xf7,0x88,0xbe,0xe3, // '{'
+	0xff,0x80,0xff, // '|'
+	0xe3,0xbe,0x88,0xf7,0x1c, // '}'
+	0x0f,0x09,0x0d,0x09,0x0b,0x09, // '~'
+};
+
+static const ssd1306_glyph_t acme_font_glyphs[]= {
+	{0, 0, 4}, // ' '
+	{0, 3, 4}, // '!'
+	{3, 5, 6}, // '"'
+	{8, 6, 7}, // '#'
+	{14, 5, 6}, // '$'
+	{19, 5, 6}, // '%'
+	{24, 6, 7}, // '&'
+	{30, 3, 4}, // '\''
+	{33, 4, 5}, // '('
+	{37, 4, 5}, // ')'
+	{41, 6, 7}, // '*'
+	{47, 6, 7}, // '+'
+	{53, 4, 5}, // ','
+	{57, 5, 6}, // '-'
+	{62, 3, 4}, // '.'
+	{65, 5, 6}, // '/'
+	{70, 5, 6}, // '0'
+	{75, 3, 4}, // '1'
+	{78, 5, 6}, // '2'
+	{83, 5, 6}, // '3'
+	{88, 5, 6}, // '4'
+	{93, 5, 6}, // '5'
+	{98, 5, 6}, // '6'
+	{103, 5, 6}, // '7'
+	{108, 5, 6}, // '8'
+	{113, 5, 6}, // '9'
+	{118, 3, 4}, // ':'
+	{121, 4, 5}, // ';'
+	{125, 5, 6}, // '<'
+	{130, 6, 7}, // '='
+	{136, 5, 6}, // '>'
+	{141, 5, 6}, // '?'
+	{146, 6, 7}, // '@'
+	{152, 5, 6}, // 'A'
+	{157, 5, 6}, // 'B'
+	{162, 5, 6}, // 'C'
+	{167, 5, 6}, // 'D'
+	{172, 5, 6}, // 'E'
+	{177, 5, 6}, // 'F'
+	{182, 5, 6}, // 'G'
+	{187, 5, 6}, // 'H'
+	{192, 3, 4}, // 'I'
+	{195, 5, 6}, // 'J'
+	{200, 5, 6}, // 'K'
+	{205, 5, 6}, // 'L'
+	{210, 6, 7}, // 'M'
+	{216, 6, 7}, // 'N'
+	{222, 5, 6}, // 'O'
+	{227, 5, 6}, // 'P'
+	{232, 5, 6}, // 'Q'
+	{237, 5, 6}, // 'R'
+	{242, 5, 6}, // 'S'
+	{247, 5, 6}, // 'T'
+	{252, 5, 6}, // 'U'
+	{257, 5, 6}, // 'V'
+	{262, 6, 7}, // 'W'
+	{268, 5, 6}, // 'X'
+	{273, 5, 6}, // 'Y'
+	{278, 5, 6}, // 'Z'
+	{283, 4, 5}, // '['
+	{287, 5, 6}, // '\\'
+	{292, 4, 5}, // ']'
+	{296, 5, 6}, // '^'
+	{301, 6, 7}, // '_'
+	{307, 4, 5}, // '`'
+	{311, 5, 6}, // 'a'
+	{316, 5, 6}, // 'b'
+	{321, 5, 6}, // 'c'
+	{326, 5, 6}, // 'd'
+	{331, 5, 6}, // 'e'
+	{336, 5, 6}, // 'f'
+	{341, 5, 6}, // 'g'
+	{346, 5, 6}, // 'h'
+	{351, 3, 4}, // 'i'
+	{354, 5, 6}, // 'j'
+	{359, 5, 6}, // 'k'
+	{364, 5, 6}, // 'l'
+	{369, 6, 7}, // 'm'
+	{375, 6, 7}, // 'n'
+	{381, 5, 6}, // 'o'
+	{386, 5, 6}, // 'p'
+	{391, 5, 6}, // 'q'
+	{396, 5, 6}, // 'r'
+	{401, 5, 6}, // 's'
+	{406, 5, 6}, // 't'
+	{411, 5, 6}, // 'u'
+	{416, 5, 6}, // 'v'
+	{421, 6, 7}, // 'w'
+	{427, 5, 6}, // 'x'
+	{432, 5, 6}, // 'y'
+	{437, 5, 6}, // 'z'
+	{442, 5, 6}, // '{'
+	{447, 3, 4}, // '|'
+	{450, 5, 6}, // '}'
+	{455, 6, 7}, // '~'
+};
+
+const ssd1306_font_t acme_font= {
+	.height=8,
+	.first=32,
+	.last=126,
+	.glyphs=acme_font_glyphs,
+	.bitmap=acme_font_bitmap,
+};
+#endif
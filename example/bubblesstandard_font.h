@@ -1,113 +1,209 @@
-#ifndef _bubblesstandard_font_h
-#define _bubblesstandard_font_h
-#include <stdint.h>
-#include "font_struct.h"
-
-const uint8_t bubblesstandard_font[] = {
-	8, 7, 0, 32, 126,
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00, //  
-	0xbf,0x00,0x00,0x00,0x00,0x00,0x00, // !
-	0x03,0x00,0x03,0x00,0x00,0x00,0x00, // "
-	0x24,0x7e,0x24,0x24,0x7e,0x24,0x00, // #
-	0x44,0x4a,0xd3,0x22,0x00,0x00,0x00, // $
-	0x82,0x60,0x18,0x06,0x21,0x00,0x00, // %
-	0x60,0x90,0x8e,0xb9,0x46,0xb0,0x00, // &
-	0x03,0x00,0x00,0x00,0x00,0x00,0x00, // '
-	0x7e,0x81,0x81,0x00,0x00,0x00,0x00, // (
-	0x81,0x81,0x7e,0x00,0x00,0x00,0x00, // )
-	0x02,0x0e,0x05,0x0e,0x02,0x00,0x00, // *
-	0x10,0x38,0x10,0x00,0x00,0x00,0x00, // +
-	0x80,0x00,0x00,0x00,0x00,0x00,0x00, // ,
-	0x10,0x10,0x10,0x00,0x00,0x00,0x00, // -
-	0x80,0x00,0x00,0x00,0x00,0x00,0x00, // .
-	0x80,0x60,0x18,0x06,0x01,0x00,0x00, // /
-	0x7e,0x81,0x81,0x7e,0x00,0x00,0x00, // 0
-	0x88,0x86,0x7f,0x40,0x00,0x00,0x00, // 1
-	0x82,0xc5,0xb1,0x8e,0x40,0x00,0x00, // 2
-	0x66,0x81,0x89,0x76,0x00,0x00,0x00, // 3
-	0x10,0x18,0x16,0xff,0x08,0x00,0x00, // 4
-	0x4e,0x8a,0x8a,0x91,0x61,0x00,0x00, // 5
-	0x20,0x78,0x96,0x91,0x60,0x00,0x00, // 6
-	0x02,0x02,0xc1,0x39,0x07,0x00,0x00, // 7
-	0x76,0x89,0x89,0x76,0x00,0x00,0x00, // 8
-	0x06,0x09,0x09,0xfe,0x00,0x00,0x00, // 9
-	0x81,0x00,0x00,0x00,0x00,0x00,0x00, // :
-	0x81,0x00,0x00,0x00,0x00,0x00,0x00, // ;
-	0x10,0x28,0x00,0x00,0x00,0x00,0x00, // <
-	0x28,0x28,0x28,0x00,0x00,0x00,0x00, // =
-	0x28,0x10,0x00,0x00,0x00,0x00,0x00, // >
-	0x06,0x01,0xb1,0x0e,0x00,0x00,0x00, // ?
-	0x3c,0x42,0x99,0xa5,0xbd,0xa2,0x1c, // @
-	0x50,0x30,0x1c,0x23,0x5c,0xe0,0x00, // A
-	0x82,0x7f,0x49,0x36,0x00,0x00,0x00, // B
-	0x3c,0x42,0x81,0x89,0x86,0x60,0x00, // C
-	0x42,0xff,0xa1,0xa1,0x82,0x7c,0x00, // D
-	0x76,0x89,0x81,0x8a,0x70,0x00,0x00, // E
-	0x90,0x70,0x1e,0x0a,0x0a,0x01,0x01, // F
-	0x3c,0x42,0x81,0xb1,0xaa,0x48,0x30, // G
-	0x45,0x3e,0x08,0x1c,0x6a,0x80,0x00, // H
-	0x84,0x82,0xff,0x41,0x40,0x00,0x00, // I
-	0x60,0x90,0x81,0x7f,0x02,0x00,0x00, // J
-	0x7e,0x08,0x16,0x61,0x80,0x00,0x00, // K
-	0x02,0xff,0x80,0x40,0x40,0x20,0x00, // L
-	0x01,0x7e,0x01,0x06,0x18,0x06,0x01, // M
-	0x80,0x7f,0x02,0x0c,0x30,0x40,0x3e, // N
-	0x3c,0x42,0x8d,0x83,0x42,0x3c,0x00, // O
-	0x8a,0x7f,0x11,0x11,0x0e,0x00,0x00, // P
-	0x3c,0x42,0x81,0xa3,0xa3,0x45,0xb8, // Q
-	0x92,0x7f,0x09,0x09,0x36,0x40,0x00, // R
-	0x60,0x8e,0x91,0xa1,0x46,0x00,0x00, // S
-	0x02,0x02,0x7f,0x81,0x01,0x00,0x00, // T
-	0x3e,0x41,0x80,0x80,0x80,0x42,0x3c, // U
-	0x01,0x06,0x38,0xc0,0x30,0x0e,0x01, // V
-	0x01,0x0e,0x30,0x40,0x20,0x18,0x60, // W
-	0x82,0x80,0x41,0x32,0x0c,0x38,0x44, // X
-	0x01,0x0e,0xf0,0x0c,0x03,0x00,0x00, // Y
-	0x04,0xc2,0xb2,0x8d,0x43,0x40,0x20, // Z
-	0xff,0x81,0x00,0x00,0x00,0x00,0x00, // [
-	0x80,0x60,0x18,0x06,0x01,0x00,0x00, // "\"
-	0x81,0xff,0x00,0x00,0x00,0x00,0x00, // ]
-	0x08,0x06,0x01,0x0e,0x10,0x00,0x00, // ^
-	0x80,0x80,0x80,0x00,0x00,0x00,0x00, // _
-	0x03,0x04,0x00,0x00,0x00,0x00,0x00, // `
-	0x64,0x92,0x92,0x92,0xfc,0x90,0x00, // a
-	0x50,0xfe,0x89,0x88,0x70,0x00,0x00, // b
-	0x78,0x84,0x82,0x82,0x84,0x60,0x00, // c
-	0x70,0x88,0x88,0xfe,0x51,0x00,0x00, // d
-	0x7c,0x92,0x92,0x8a,0x64,0x10,0x00, // e
-	0x90,0x7e,0x09,0x01,0x00,0x00,0x00, // f
-	0x00,0x78,0x84,0x84,0xfe,0x44,0x00, // g
-	0x01,0x7e,0x08,0x08,0x70,0x80,0x00, // h
-	0x04,0x7d,0x80,0x00,0x00,0x00,0x00, // i
-	0x00,0xfd,0x04,0x00,0x00,0x00,0x00, // j
-	0x81,0x7e,0x08,0x34,0x40,0x00,0x00, // k
-	0x01,0x7e,0x80,0x00,0x00,0x00,0x00, // l
-	0x3e,0x04,0x04,0x18,0x04,0x04,0x78, // m
-	0x7e,0x04,0x04,0x78,0x80,0x00,0x00, // n
-	0x7c,0x82,0x86,0x84,0x78,0x00,0x00, // o
-	0x48,0xfe,0x84,0x84,0x78,0x00,0x00, // p
-	0x78,0x84,0x84,0xfe,0x48,0x00,0x00, // q
-	0x82,0x7c,0x02,0x02,0x04,0x00,0x00, // r
-	0x60,0x8c,0x92,0x62,0x04,0x00,0x00, // s
-	0x08,0x7f,0x84,0x90,0x60,0x00,0x00, // t
-	0x02,0x7c,0x80,0x80,0x80,0x78,0x80, // u
-	0x02,0x0c,0x70,0x80,0x78,0x04,0x00, // v
-	0x02,0x0c,0x70,0x80,0x60,0x18,0x60, // w
-	0x86,0x64,0x18,0x66,0x80,0x00,0x00, // x
-	0x02,0x7c,0x80,0x80,0xf8,0x00,0x00, // y
-	0x08,0x84,0xc4,0xb2,0x8e,0x40,0x00, // z
-	0xee,0x01,0x00,0x00,0x00,0x00,0x00, // {
-	0xff,0x00,0x00,0x00,0x00,0x00,0x00, // |
-	0x01,0xee,0x10,0x00,0x00,0x00,0x00, // }
-	0x10,0x08,0x08,0x10,0x10,0x08,0x00, // ~
-	0x00,0x00,0x00,0x00,0x00,0x00,0x00
-};
-
-const font bubblesstandard = {
-	.bitmap_buffer =  (const char *)&bubblesstandard_font[5] ,
-	.first_char_in_font = 32,
-	.bytes_per_char = 7,
-	.char_width = 7,
-	.char_height = 8,
-};
-#endif
+#ifndef _bubblesstandard_font_h
+#define _bubblesstandard_font_h
+#include <stdint.h>
+#include "font_struct.h"
+
+// generated by tools/fontconv -p from bubblesstandard_font
+static const uint8_t bubblesstandard_font_bitmap[]= {
+	0xbf, // '!'
+	0x03,0x00,0x03, // '"'
+	0x24,0x7e,0x24,0x24,0x7e,0x24, // '#'
+	0x44,0x4a,0xd3,0x22, // '$'
+	0x82,0x60,0x18,0x06,0x21, // '%'
+	0x60,0x90,0x8e,0xb9,0x46,0xb0, // '&'
+	0x03, // '\''
+	0x7e,0x81,0x81, // '('
+	0x81,0x81,0x7e, // ')'
+	0x02,0x0e,0x05,0x0e,0x02, // '*'
+	0x10,0x38,0x10, // '+'
+	0x80, // ','
+	0x10,0x10,0x10, // '-'
+	0x80, // '.'
+	0x80,0x60,0x18,0x06,0x01, // '/'
+	0x7e,0x81,0x81,0x7e, // '0'
+	0x88,0x86,0x7f,0x40, // '1'
+	0x82,0xc5,0xb1,0x8e,0x40, // '2'
+	0x66,0x81,0x89,0x76, // '3'
+	0x10,0x18,0x16,0xff,0x08, // '4'
+	0x4e,0x8a,0x8a,0x91,0x61, // '5'
+	0x20,0x78,0x96,0x91,0x60, // '6'
+	0x02,0x02,0xc1,0x39,0x07, // '7'
+	0x76,0x89,0x89,0x76, // '8'
+	0x06,0x09,0x09,0xfe, // '9'
+	0x81, // ':'
+	0x81, // ';'
+	0x10,0x28, // '<'
+	0x28,0x28,0x28, // '='
+	0x28,0x10, // '>'
+	0x06,0x01,0xb1,0x0e, // '?'
+	0x3c,0x42,0x99,0xa5,0xbd,0xa2,0x1c, // '@'
+	0x50,0x30,0x1c,0x23,0x5c,0xe0, // 'A'
+	0x82,0x7f,0x49,0x36, // 'B'
+	0x3c,0x42,0x81,0x89,0x86,0x60, // 'C'
+	0x42,0xff,0xa1,0xa1,0x82,0x7c, // 'D'
+	0x76,0x89,0x81,0x8a,0x70, // 'E'
+	0x90,0x70,0x1e,0x0a,0x0a,0x01,0x01, // 'F'
+	0x3c,0x42,0x81,0xb1,0xaa,0x48,0x30, // 'G'
+	0x45,0x3e,0x08,0x1c,0x6a,0x80, // 'H'
+	0x84,0x82,0xff,0x41,0x40, // 'I'
+	0x60,0x90,0x81,0x7f,0x02, // 'J'
+	0x7e,0x08,0x16,0x61,0x80, // 'K'
+	0x02,0xff,0x80,0x40,0x40,0x20, // 'L'
+	0x01,0x7e,0x01,0x06,0x18,0x06,0x01, // 'M'
+	0x80,0x7f,0x02,0x0c,0x30,0x40,0x3e, // 'N'
+	0x3c,0x42,0x8d,0x83,0x42,0x3c, // 'O'
+	0x8a,0x7f,0x11,0x11,0x0e, // 'P'
+	0x3c,0x42,0x81,0xa3,0xa3,0x45,0xb8, // 'Q'
+	0x92,0x7f,0x09,0x09,0x36,0x40, // 'R'
+	0x60,0x8e,0x91,0xa1,0x46, // 'S'
+	0x02,0x02,0x7f,0x81,0x01, // 'T'
+	0x3e,0x41,0x80,0x80,0x80,0x42,0x3c, // 'U'
+	0x01,0x06,0x38,0xc0,0x30,0x0e,0x01, // 'V'
+	0x01,0x0e,0x30,0x40,0x20,0x18,0x60, // 'W'
+	0x82,0x80,0x41,0x32,0x0c,0x38,0x44, // 'X'
+	0x01,0x0e,0xf0,0x0c,0x03, // 'Y'
+	0x04,0xc2,0xb2,0x8d,0x43,0x40,0x20, // 'Z'
+	0xff,0x81, // '['
+	0x80,0x60,0x18,0x06,0x01, // '\\'
+	0x81,0xff, // ']'
+	0x08,0x06,0x01,0x0e,0x10, // '^'
+	0x80,0x80,0x80, // '_'
+	0x03,0x04, // '`'
+	0x64,0x92,0x92,0x92,0xfc,0x90, // 'a'
+	0x50,0xfe,0x89,0x88,0x70, // 'b'
+	0x78,0x84,0x82,0x82,0x84,0x60, // 'c'
+	0x70,0x88,0x88,0xfe,0x51, // 'd'
+	0x7c,0x92,0x92,0x8a,0x64,0x10, // 'e'
+	0x90,0x7e,0x09,0x01, // 'f'
+	0x78,0x84,0x84,0xfe,0x44, // 'g'
+	0x01,0x7e,0x08,0x08,0x70,0x80, // 'h'
+	0x04,0x7d,0x80, // 'i'
+	0xfd,0x04, // 'j'
+	0x81,0x7e,0x08,0x34,0x40, // 'k'
+	0x01,0x7e,0x80, // 'l'
+	0x3e,0x04,0x04,0x18,0x04,0x04,0x78, // 'm'
+	0x7e,0x04,0x04,0x78,0x80, // 'n'
+	0x7c,0x82,0x86,0x84,0x78, // 'o'
+	0x48,0xfe,0x84,0x84,0x78, // 'p'
+	0x78,0x84,0x84,0xfe,0x48, // 'q'
+	0x82,0x7c,0x02,0x02,0x04, // 'r'
+	0x60,0x8c,0x92,0x62,0x04, // 's'
+	0x08,0x7f,0x84,0x90,0x60, // 't'
+	0x02,0x7c,0x80,0x80,0x80,0x78,0x80, // 'u'
+	0x02,0x0c,0x70,0x80,0x78,0x04, // 'v'
+	0x02,0x0c,0x70,0x80,0x60,0x18,0x60, // 'w'
+	0x86,0x64,0x18,0x66,0x80, // 'x'
+	0x02,0x7c,0x80,0x80,0xf8, // 'y'
+	0x08,0x84,0xc4,0xb2,0x8e,0x40, // 'z'
+	0xee,0x01, // '{'
+	0xff, // '|'
+	0x01,0xee,0x10, // '}'
+	0x10,0x08,0x08,0x10,0x10,0x08, // '~'
+};
+
+static const ssd1306_glyph_t bubblesstandard_font_glyphs[]= {
+	{0, 0, 4}, // ' '
+	{0, 1, 1}, // '!'
+	{1, 3, 3}, // '"'
+	{4, 6, 6}, // '#'
+	{10, 4, 4}, // '$'
+	{14, 5, 5}, // '%'
+	{19, 6, 6}, // '&'
+	{25, 1, 1}, // '\''
+	{26, 3, 3}, // '('
+	{29, 3, 3}, // ')'
+	{32, 5, 5}, // '*'
+	{37, 3, 3}, // '+'
+	{40, 1, 1}, // ','
+	{41, 3, 3}, // '-'
+	{44, 1, 1}, // '.'
+	{45, 5, 5}, // '/'
+	{50, 4, 4}, // '0'
+	{54, 4, 4}, // '1'
+	{58, 5, 5}, // '2'
+	{63, 4, 4}, // '3'
+	{67, 5, 5}, // '4'
+	{72, 5, 5}, // '5'
+	{77, 5, 5}, // '6'
+	{82, 5, 5}, // '7'
+	{87, 4, 4}, // '8'
+	{91, 4, 4}, // '9'
+	{95, 1, 1}, // ':'
+	{96, 1, 1}, // ';'
+	{97, 2, 2}, // '<'
+	{99, 3, 3}, // '='
+	{102, 2, 2}, // '>'
+	{104, 4, 4}, // '?'
+	{108, 7, 7}, // '@'
+	{115, 6, 6}, // 'A'
+	{121, 4, 4}, // 'B'
+	{125, 6, 6}, // 'C'
+	{131, 6, 6}, // 'D'
+	{137, 5, 5}, // 'E'
+	{142, 7, 7}, // 'F'
+	{149, 7, 7}, // 'G'
+	{156, 6, 6}, // 'H'
+	{162, 5, 5}, // 'I'
+	{167, 5, 5}, // 'J'
+	{172, 5, 5}, // 'K'
+	{177, 6, 6}, // 'L'
+	{183, 7, 7}, // 'M'
+	{190, 7, 7}, // 'N'
+	{197, 6, 6}, // 'O'
+	{203, 5, 5}, // 'P'
+	{208, 7, 7}, // 'Q'
+	{215, 6, 6}, // 'R'
+	{221, 5, 5}, // 'S'
+	{226, 5, 5}, // 'T'
+	{231, 7, 7}, // 'U'
+	{238, 7, 7}, // 'V'
+	{245, 7, 7}, // 'W'
+	{252, 7, 7}, // 'X'
+	{259, 5, 5}, // 'Y'
+	{264, 7, 7}, // 'Z'
+	{271, 2, 2}, // '['
+	{273, 5, 5}, // '\\'
+	{278, 2, 2}, // ']'
+	{280, 5, 5}, // '^'
+	{285, 3, 3}, // '_'
+	{288, 2, 2}, // '`'
+	{290, 6, 6}, // 'a'
+	{296, 5, 5}, // 'b'
+	{301, 6, 6}, // 'c'
+	{307, 5, 5}, // 'd'
+	{312, 6, 6}, // 'e'
+	{318, 4, 4}, // 'f'
+	{322, 5, 5}, // 'g'
+	{327, 6, 6}, // 'h'
+	{333, 3, 3}, // 'i'
+	{336, 2, 2}, // 'j'
+	{338, 5, 5}, // 'k'
+	{343, 3, 3}, // 'l'
+	{346, 7, 7}, // 'm'
+	{353, 5, 5}, // 'n'
+	{358, 5, 5}, // 'o'
+	{363, 5, 5}, // 'p'
+	{368, 5, 5}, // 'q'
+	{373, 5, 5}, // 'r'
+	{378, 5, 5}, // 's'
+	{383, 5, 5}, // 't'
+	{388, 7, 7}, // 'u'
+	{395, 6, 6}, // 'v'
+	{401, 7, 7}, // 'w'
+	{408, 5, 5}, // 'x'
+	{413, 5, 5}, // 'y'
+	{418, 6, 6}, // 'z'
+	{424, 2, 2}, // '{'
+	{426, 1, 1}, // '|'
+	{427, 3, 3}, // '}'
+	{430, 6, 6}, // '~'
+};
+
+const ssd1306_font_t bubblesstandard_font= {
+	.height=8,
+	.first=32,
+	.last=126,
+	.glyphs=bubblesstandard_font_glyphs,
+	.bitmap=bubblesstandard_font_bitmap,
+};
+#endif
@@ -1,113 +1,209 @@
-#ifndef _crackers_font_h
-#define _crackers_font_h
-#include <stdint.h>
-#include "font_struct.h"
-
-const unsigned char crackers_font[] = {
-	8, 6, 2, 32, 126,
-	0x00,0x00,0x00,0x00,0x00,0x00, //  
-	0x5e,0x06,0x06,0x00,0x00,0x00, // !
-	0x1e,0x00,0x00,0x1e,0x00,0x00, // "
-	0x20,0x7c,0x38,0x38,0x7c,0x08, // #
-	0x48,0xfe,0x64,0x64,0x00,0x00, // $
-	0x64,0x60,0x60,0x18,0x0c,0x0c, // %
-	0x74,0x4a,0x4a,0x7e,0x48,0x00, // &
-	0x1e,0x00,0x00,0x00,0x00,0x00, // '
-	0x3c,0x7e,0x7e,0x42,0x00,0x00, // (
-	0x42,0x7e,0x7e,0x3c,0x00,0x00, // )
-	0x04,0x0c,0x04,0x06,0x0c,0x04, // *
-	0x10,0x3c,0x3c,0x3c,0x10,0x00, // +
-	0x00,0x60,0xe0,0x00,0x00,0x00, // ,
-	0x08,0x08,0x08,0x00,0x00,0x00, // -
-	0x60,0x60,0x60,0x00,0x00,0x00, // .
-	0x60,0x78,0x78,0x1e,0x06,0x00, // /
-	0x3c,0x3c,0x7e,0x42,0x7e,0x7e, // 0
-	0x04,0x7e,0x7e,0x7e,0x00,0x00, // 1
-	0x76,0x7a,0x7e,0x7e,0x4c,0x00, // 2
-	0x4a,0x7e,0x7e,0x7c,0x00,0x00, // 3
-	0x0e,0x08,0x7e,0x7e,0x7e,0x00, // 4
-	0x4e,0x4e,0x4e,0x7a,0x1a,0x00, // 5
-	0x3c,0x7e,0x7e,0x4a,0x7a,0x00, // 6
-	0x02,0x02,0x0a,0x7e,0x7e,0x7e, // 7
-	0x7e,0x7e,0x7e,0x4a,0x7e,0x00, // 8
-	0x0c,0x4a,0x7e,0x7e,0x3c,0x00, // 9
-	0x66,0x66,0x66,0x00,0x00,0x00, // :
-	0x66,0xe6,0x00,0x00,0x00,0x00, // ;
-	0x08,0x3c,0x7e,0x7e,0x62,0x00, // <
-	0x14,0x14,0x14,0x00,0x00,0x00, // =
-	0x62,0x7e,0x7e,0x3c,0x08,0x00, // >
-	0x02,0x4a,0x0e,0x0e,0x0c,0x00, // ?
-	0x3c,0x7e,0x7e,0x4a,0x72,0x30, // @
-	0x7a,0x4a,0x7e,0x7e,0x7c,0x00, // A
-	0x7e,0x7e,0x7e,0x4a,0x24,0x00, // B
-	0x3c,0x7e,0x7e,0x7e,0x46,0x00, // C
-	0x7e,0x7e,0x7e,0x62,0x3c,0x00, // D
-	0x7e,0x7e,0x7e,0x4a,0x00,0x00, // E
-	0x7e,0x7e,0x7e,0x0a,0x00,0x00, // F
-	0x3c,0x7e,0x7e,0x42,0x62,0x00, // G
-	0x7e,0x7e,0x7e,0x18,0x7e,0x00, // H
-	0x7e,0x7e,0x7e,0x00,0x00,0x00, // I
-	0x40,0x7e,0x7e,0x7e,0x00,0x00, // J
-	0x7e,0x7e,0x7e,0x3c,0x66,0x00, // K
-	0x7e,0x7e,0x7e,0x40,0x00,0x00, // L
-	0x7e,0x3e,0x3e,0x7c,0x3e,0x3e, // M
-	0x7e,0x3e,0x7e,0x7c,0x7e,0x00, // N
-	0x3c,0x3c,0x7e,0x62,0x7e,0x7e, // O
-	0x7e,0x7e,0x7e,0x22,0x0c,0x00, // P
-	0x3c,0x7e,0x7e,0x62,0x7e,0x7c, // Q
-	0x7e,0x7e,0x7e,0x0a,0x64,0x00, // R
-	0x4c,0x4e,0x4e,0x7a,0x1a,0x00, // S
-	0x02,0x7e,0x7e,0x7e,0x02,0x00, // T
-	0x7e,0x60,0x7e,0x7e,0x7e,0x00, // U
-	0x3e,0x60,0x7e,0x7e,0x3e,0x00, // V
-	0x7e,0x7c,0x7c,0x3e,0x7c,0x7c, // W
-	0x46,0x7e,0x08,0x7e,0x62,0x62, // X
-	0x5e,0x5e,0x5e,0x70,0x3e,0x00, // Y
-	0x66,0x7a,0x7a,0x5e,0x66,0x00, // Z
-	0x7e,0x7e,0x7e,0x42,0x00,0x00, // [
-	0x06,0x1e,0x1e,0x78,0x60,0x00, // "\"
-	0x42,0x7e,0x7e,0x7e,0x00,0x00, // ]
-	0x0c,0x06,0x0c,0x00,0x00,0x00, // ^
-	0x40,0x40,0x40,0x40,0x40,0x00, // _
-	0x02,0x06,0x06,0x04,0x00,0x00, // `
-	0x78,0x24,0x7c,0x7c,0x78,0x00, // a
-	0x7c,0x7c,0x7c,0x48,0x20,0x00, // b
-	0x18,0x7c,0x7c,0x7c,0x4c,0x00, // c
-	0x20,0x48,0x7c,0x7c,0x7c,0x00, // d
-	0x18,0x7c,0x7c,0x74,0x4c,0x00, // e
-	0x78,0x7c,0x7c,0x24,0x00,0x00, // f
-	0x18,0x7c,0x7c,0x44,0x74,0x00, // g
-	0x7c,0x7c,0x7c,0x08,0x60,0x00, // h
-	0x7c,0x7c,0x7c,0x00,0x00,0x00, // i
-	0x40,0x7c,0x7c,0x7c,0x00,0x00, // j
-	0x7c,0x7c,0x7c,0x20,0x48,0x00, // k
-	0x7c,0x7c,0x7c,0x40,0x00,0x00, // l
-	0x7c,0x3c,0x3c,0x78,0x3c,0x3c, // m
-	0x7c,0x7c,0x7c,0x04,0x78,0x00, // n
-	0x18,0x18,0x7c,0x44,0x7c,0x7c, // o
-	0x7c,0x7c,0x7c,0x24,0x08,0x00, // p
-	0x18,0x18,0x7c,0x44,0x7c,0x7c, // q
-	0x7c,0x7c,0x7c,0x04,0x00,0x00, // r
-	0x5c,0x7c,0x7c,0x74,0x00,0x00, // s
-	0x08,0x7c,0x7c,0x7c,0x48,0x00, // t
-	0x7c,0x60,0x7c,0x7c,0x7c,0x00, // u
-	0x3c,0x60,0x7c,0x7c,0x3c,0x00, // v
-	0x7c,0x78,0x78,0x3c,0x78,0x78, // w
-	0x4c,0x3c,0x3c,0x78,0x64,0x00, // x
-	0x4c,0x4c,0x4c,0x78,0x3c,0x00, // y
-	0x5c,0x74,0x44,0x5c,0x74,0x00, // z
-	0x24,0x7e,0x42,0x42,0x00,0x00, // {
-	0x7e,0x00,0x00,0x00,0x00,0x00, // |
-	0x42,0x7e,0x24,0x00,0x00,0x00, // }
-	0x04,0x06,0x06,0x02,0x04,0x06, // ~
-	0x00,0x00,0x00,0x00,0x00,0x00
-};
-
-const font crackers = {
-	.bitmap_buffer =  (const char *)&crackers_font[5] ,
-	.first_char_in_font = 32,
-	.bytes_per_char = 6,
-	.char_width = 6,
-	.char_height = 8,
-};
-#endif
+#ifndef _crackers_font_h
+#define _crackers_font_h
+#include <stdint.h>
+#include "font_struct.h"
+
+// generated by tools/fontconv -p from crackers_font
+static const uint8_t crackers_font_bitmap[]= {
+	0x5e,0x06,0x06, // '!'
+	0x1e,0x00,0x00,0x1e, // '"'
+	0x20,0x7c,0x38,0x38,0x7c,0x08, // '#'
+	0x48,0xfe,0x64,0x64, // '$'
+	0x64,0x60,0x60,0x18,0x0c,0x0c, // '%'
+	0x74,0x4a,0x4a,0x7e,0x48, // '&'
+	0x1e, // '\''
+	0x3c,0x7e,0x7e,0x42, // '('
+	0x42,0x7e,0x7e,0x3c, // ')'
+	0x04,0x0c,0x04,0x06,0x0c,0x04, // '*'
+	0x10,0x3c,0x3c,0x3c,0x10, // '+'
+	0x60,0xe0, // ','
+	0x08,0x08,0x08, // '-'
+	0x60,0x60,0x60, // '.'
+	0x60,0x78,0x78,0x1e,0x06, // '/'
+	0x3c,0x3c,0x7e,0x42,0x7e,0x7e, // '0'
+	0x04,0x7e,0x7e,0x7e, // '1'
+	0x76,0x7a,0x7e,0x7e,0x4c, // '2'
+	0x4a,0x7e,0x7e,0x7c, // '3'
+	0x0e,0x08,0x7e,0x7e,0x7e, // '4'
+	0x4e,0x4e,0x4e,0x7a,0x1a, // '5'
+	0x3c,0x7e,0x7e,0x4a,0x7a, // '6'
+	0x02,0x02,0x0a,0x7e,0x7e,0x7e, // '7'
+	0x7e,0x7e,0x7e,0x4a,0x7e, // '8'
+	0x0c,0x4a,0x7e,0x7e,0x3c, // '9'
+	0x66,0x66,0x66, // ':'
+	0x66,0xe6, // ';'
+	0x08,0x3c,0x7e,0x7e,0x62, // '<'
+	0x14,0x14,0x14, // '='
+	0x62,0x7e,0x7e,0x3c,0x08, // '>'
+	0x02,0x4a,0x0e,0x0e,0x0c, // '?'
+	0x3c,0x7e,0x7e,0x4a,0x72,0x30, // '@'
+	0x7a,0x4a,0x7e,0x7e,0x7c, // 'A'
+	0x7e,0x7e,0x7e,0x4a,0x24, // 'B'
+	0x3c,0x7e,0x7e,0x7e,0x46, // 'C'
+	0x7e,0x7e,0x7e,0x62,0x3c, // 'D'
+	0x7e,0x7e,0x7e,0x4a, // 'E'
+	0x7e,0x7e,0x7e,0x0a, // 'F'
+	0x3c,0x7e,0x7e,0x42,0x62, // 'G'
+	0x7e,0x7e,0x7e,0x18,0x7e, // 'H'
+	0x7e,0x7e,0x7e, // 'I'
+	0x40,0x7e,0x7e,0x7e, // 'J'
+	0x7e,0x7e,0x7e,0x3c,0x66, // 'K'
+	0x7e,0x7e,0x7e,0x40, // 'L'
+	0x7e,0x3e,0x3e,0x7c,0x3e,0x3e, // 'M'
+	0x7e,0x3e,0x7e,0x7c,0x7e, // 'N'
+	0x3c,0x3c,0x7e,0x62,0x7e,0x7e, // 'O'
+	0x7e,0x7e,0x7e,0x22,0x0c, // 'P'
+	0x3c,0x7e,0x7e,0x62,0x7e,0x7c, // 'Q'
+	0x7e,0x7e,0x7e,0x0a,0x64, // 'R'
+	0x4c,0x4e,0x4e,0x7a,0x1a, // 'S'
+	0x02,0x7e,0x7e,0x7e,0x02, // 'T'
+	0x7e,0x60,0x7e,0x7e,0x7e, // 'U'
+	0x3e,0x60,0x7e,0x7e,0x3e, // 'V'
+	0x7e,0x7c,0x7c,0x3e,0x7c,0x7c, // 'W'
+	0x46,0x7e,0x08,0x7e,0x62,0x62, // 'X'
+	0x5e,0x5e,0x5e,0x70,0x3e, // 'Y'
+	0x66,0x7a,0x7a,0x5e,0x66, // 'Z'
+	0x7e,0x7e,0x7e,0x42, // '['
+	0x06,0x1e,0x1e,0x78,0x60, // '\\'
+	0x42,0x7e,0x7e,0x7e, // ']'
+	0x0c,0x06,0x0c, // '^'
+	0x40,0x40,0x40,0x40,0x40, // '_'
+	0x02,0x06,0x06,0x04, // '`'
+	0x78,0x24,0x7c,0x7c,0x78, // 'a'
+	0x7c,0x7c,0x7c,0x48,0x20, // 'b'
+	0x18,0x7c,0x7c,0x7c,0x4c, // 'c'
+	0x20,0x48,0x7c,0x7c,0x7c, // 'd'
+	0x18,0x7c,0x7c,0x74,0x4c, // 'e'
+	0x78,0x7c,0x7c,0x24, // 'f'
+	0x18,0x7c,0x7c,0x44,0x74, // 'g'
+	0x7c,0x7c,0x7c,0x08,0x60, // 'h'
+	0x7c,0x7c,0x7c, // 'i'
+	0x40,0x7c,0x7c,0x7c, // 'j'
+	0x7c,0x7c,0x7c,0x20,0x48, // 'k'
+	0x7c,0x7c,0x7c,0x40, // 'l'
+	0x7c,0x3c,0x3c,0x78,0x3c,0x3c, // 'm'
+	0x7c,0x7c,0x7c,0x04,0x78, // 'n'
+	0x18,0x18,0x7c,0x44,0x7c,0x7c, // 'o'
+	0x7c,0x7c,0x7c,0x24,0x08, // 'p'
+	0x18,0x18,0x7c,0x44,0x7c,0x7c, // 'q'
+	0x7c,0x7c,0x7c,0x04, // 'r'
+	0x5c,0x7c,0x7c,0x74, // 's'
+	0x08,0x7c,0x7c,0x7c,0x48, // 't'
+	0x7c,0x60,0x7c,0x7c,0x7c, // 'u'
+	0x3c,0x60,0x7c,0x7c,0x3c, // 'v'
+	0x7c,0x78,0x78,0x3c,0x78,0x78, // 'w'
+	0x4c,0x3c,0x3c,0x78,0x64, // 'x'
+	0x4c,0x4c,0x4c,0x78,0x3c, // 'y'
+	0x5c,0x74,0x44,0x5c,0x74, // 'z'
+	0x24,0x7e,0x42,0x42, // '{'
+	0x7e, // '|'
+	0x42,0x7e,0x24, // '}'
+	0x04,0x06,0x06,0x02,0x04,0x06, // '~'
+};
+
+static const ssd1306_glyph_t crackers_font_glyphs[]= {
+	{0, 0, 5}, // ' '
+	{0, 3, 5}, // '!'
+	{3, 4, 6}, // '"'
+	{7, 6, 8}, // '#'
+	{13, 4, 6}, // '$'
+	{17, 6, 8}, // '%'
+	{23, 5, 7}, // '&'
+	{28, 1, 3}, // '\''
+	{29, 4, 6}, // '('
+	{33, 4, 6}, // ')'
+	{37, 6, 8}, // '*'
+	{43, 5, 7}, // '+'
+	{48, 2, 4}, // ','
+	{50, 3, 5}, // '-'
+	{53, 3, 5}, // '.'
+	{56, 5, 7}, // '/'
+	{61, 6, 8}, // '0'
+	{67, 4, 6}, // '1'
+	{71, 5, 7}, // '2'
+	{76, 4, 6}, // '3'
+	{80, 5, 7}, // '4'
+	{85, 5, 7}, // '5'
+	{90, 5, 7}, // '6'
+	{95, 6, 8}, // '7'
+	{101, 5, 7}, // '8'
+	{106, 5, 7}, // '9'
+	{111, 3, 5}, // ':'
+	{114, 2, 4}, // ';'
+	{116, 5, 7}, // '<'
+	{121, 3, 5}, // '='
+	{124, 5, 7}, // '>'
+	{129, 5, 7}, // '?'
+	{134, 6, 8}, // '@'
+	{140, 5, 7}, // 'A'
+	{145, 5, 7}, // 'B'
+	{150, 5, 7}, // 'C'
+	{155, 5, 7}, // 'D'
+	{160, 4, 6}, // 'E'
+	{164, 4, 6}, // 'F'
+	{168, 5, 7}, // 'G'
+	{173, 5, 7}, // 'H'
+	{178, 3, 5}, // 'I'
+	{181, 4, 6}, // 'J'
+	{185, 5, 7}, // 'K'
+	{190, 4, 6}, // 'L'
+	{194, 6, 8}, // 'M'
+	{200, 5, 7}, // 'N'
+	{205, 6, 8}, // 'O'
+	{211, 5, 7}, // 'P'
+	{216, 6, 8}, // 'Q'
+	{222, 5, 7}, // 'R'
+	{227, 5, 7}, // 'S'
+	{232, 5, 7}, // 'T'
+	{237, 5, 7}, // 'U'
+	{242, 5, 7}, // 'V'
+	{247, 6, 8}, // 'W'
+	{253, 6, 8}, // 'X'
+	{259, 5, 7}, // 'Y'
+	{264, 5, 7}, // 'Z'
+	{269, 4, 6}, // '['
+	{273, 5, 7}, // '\\'
+	{278, 4, 6}, // ']'
+	{282, 3, 5}, // '^'
+	{285, 5, 7}, // '_'
+	{290, 4, 6}, // '`'
+	{294, 5, 7}, // 'a'
+	{299, 5, 7}, // 'b'
+	{304, 5, 7}, // 'c'
+	{309, 5, 7}, // 'd'
+	{314, 5, 7}, // 'e'
+	{319, 4, 6}, // 'f'
+	{323, 5, 7}, // 'g'
+	{328, 5, 7}, // 'h'
+	{333, 3, 5}, // 'i'
+	{336, 4, 6}, // 'j'
+	{340, 5, 7}, // 'k'
+	{345, 4, 6}, // 'l'
+	{349, 6, 8}, // 'm'
+	{355, 5, 7}, // 'n'
+	{360, 6, 8}, // 'o'
+	{366, 5, 7}, // 'p'
+	{371, 6, 8}, // 'q'
+	{377, 4, 6}, // 'r'
+	{381, 4, 6}, // 's'
+	{385, 5, 7}, // 't'
+	{390, 5, 7}, // 'u'
+	{395, 5, 7}, // 'v'
+	{400, 6, 8}, // 'w'
+	{406, 5, 7}, // 'x'
+	{411, 5, 7}, // 'y'
+	{416, 5, 7}, // 'z'
+	{421, 4, 6}, // '{'
+	{425, 1, 3}, // '|'
+	{426, 3, 5}, // '}'
+	{429, 6, 8}, // '~'
+};
+
+const ssd1306_font_t crackers_font= {
+	.height=8,
+	.first=32,
+	.last=126,
+	.glyphs=crackers_font_glyphs,
+	.bitmap=crackers_font_bitmap,
+};
+#endif
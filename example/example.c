@@ -12,8 +12,7 @@
 #include "BMSPA_font.h"
 #include "font.h"
 
-const uint8_t num_chars_per_disp[]={7,7,7,5};
-const uint8_t *fonts[] = {acme_font, bubblesstandard_font, crackers_font, BMSPA_font};
+const ssd1306_font_t *fonts[] = {&acme_font, &bubblesstandard_font, &crackers_font, &BMSPA_font};
 
 #define SLEEPTIME 30
 #ifdef SSD1306_USE_DMA
@@ -64,7 +63,7 @@ void animation(void) {
 
     printf("ANIMATION!\n");
 
-    char buf[8];
+    char buf[32];
 
     for(;;) {
         for(int y=0; y<31; ++y) {
@@ -100,15 +99,19 @@ void animation(void) {
         for(size_t font_i=0; font_i<sizeof(fonts)/sizeof(fonts[0]); ++font_i) {
             uint8_t c=32;
             while(c<=126) {
+                // as many characters as fit, the fonts are proportional
                 uint8_t i=0;
-                for(; i<num_chars_per_disp[font_i]; ++i) {
-                    if(c>126)
+                for(buf[0]=0; c<=126 && i<sizeof(buf)-1; ++i) {
+                    buf[i]=c;
+                    buf[i+1]=0;
+                    if(i>0 && ssd1306_text_width(fonts[font_i], 2, buf)>128-8) {
+                        buf[i]=0;
                         break;
-                    buf[i]=c++;
+                    }
+                    ++c;
                 }
-                buf[i]=0;
 
-                ssd1306_draw_string_with_font(&display_01, 8, 24, 2, fonts[font_i], buf);
+                ssd1306_draw_text(&display_01, 8, 24, 2, fonts[font_i], buf);
                 ssd1306_show(&display_01);
                 sleep_ms(800);
                 ssd1306_clear(&display_01);
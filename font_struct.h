@@ -1,14 +1,45 @@
 #ifndef _font_struct_h
 #define _font_struct_h
 #include <stdint.h>
+
 /**
- * Struct that holds a font and all relevant information
+ * Position of a glyph in the bitmap of its font
  */
 typedef struct {
-    uint16_t bytes_per_char; // the size of the char sprite in bytes (including padding)
-    uint16_t char_width; // width of the caracter in pixels (how many columns the sprite spans)
-    char first_char_in_font; // the first char that is included in the font
-    uint16_t char_height; // height of the character in pixels (how many rows the sprite spans)
-    const char *bitmap_buffer;
-} font;
+    uint16_t offset; // index of the first column of the glyph in bitmap
+    uint8_t width; // columns of the glyph, 0 for glyphs without pixels like the space
+    uint8_t advance; // distance from the start of the glyph to the start of the next one
+} ssd1306_glyph_t;
+
+/**
+ * Spacing correction between two glyphs, e.g. to move 'o' closer to 'T'
+ */
+typedef struct {
+    uint16_t left; // index of the left glyph
+    uint16_t right; // index of the right glyph
+    int8_t adjust; // added to the advance of the left glyph
+} ssd1306_kerning_t;
+
+/**
+ * Font drawn by ssd1306_draw_text
+ *
+ * Every glyph column is stored as (height+7)/8 bytes, the top row in bit 0 of the first one,
+ * like the columns of the raw fonts in font.h. Fonts in this format are written by tools/fontconv
+ * from raw fonts and by tools/bdf2c from BDF and PCF fonts.
+ *
+ * The glyphs of the code points first to last come first and are found by indexing. Any further
+ * glyphs, e.g. umlauts or a few CJK characters, follow them and are found by a binary search over
+ * their code points, so a font only stores the glyphs it has.
+ */
+typedef struct {
+    uint8_t height; // rows of the glyphs
+    uint8_t first; // code point of the first glyph of the dense range
+    uint8_t last; // code point of the last glyph of the dense range, first>last if there is none
+    const ssd1306_glyph_t *glyphs; // last-first+1 glyphs of the dense range, then the sparse glyphs
+    const uint8_t *bitmap; // columns of all glyphs
+    const ssd1306_kerning_t *kerning; // pairs sorted by left and then right glyph, may be NULL
+    uint16_t kernings; // number of kerning pairs
+    const uint32_t *codepoints; // ascending code points of the sparse glyphs, may be NULL
+    uint16_t sparse; // number of sparse glyphs
+} ssd1306_font_t;
 #endif
@@ -0,0 +1,354 @@
+/*
+ * benchmark for the drawing primitives
+ *
+ * on the host build with `make` and run `./bench`, `./bench -c` prints csv
+ * with BENCH_PICO defined it runs on the pico and prints csv, see example/CMakeLists.txt
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ssd1306.h"
+#include "font.h"
+#include "basic_font.h"
+#include "image.h"
+#include "test_bmp_rle.h"
+
+#ifdef BENCH_PICO
+#include "pico/stdlib.h"
+
+#define MIN_SECONDS 0.5
+// calls between two looks at the clock
+#define BATCH 10
+
+static double now(void) {
+    return time_us_64()*1e-6;
+}
+#else
+#include <time.h>
+
+#define MIN_SECONDS 0.2
+#define BATCH 1000
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec+ts.tv_nsec*1e-9;
+}
+#endif
+
+typedef struct {
+    const char *name;
+    void (*run)(ssd1306_t *p, uint32_t i);
+    uint32_t pixels;		/**< pixels touched per call, 0 if it varies */
+    bool show;			/**< whether ssd1306_show is timed after every call */
+} bench_t;
+
+// fills the rectangle pixel by pixel, like ssd1306_draw_square did before it worked on page bytes
+static void fill_pixelwise(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    for(uint32_t i=0; i<width; ++i)
+        for(uint32_t j=0; j<height; ++j)
+            ssd1306_draw_pixel(p, x+i, y+j);
+}
+
+static void screen_pixelwise(ssd1306_t *p, uint32_t i) {
+    fill_pixelwise(p, 0, 0, 128, 64);
+}
+
+static void screen_square(ssd1306_t *p, uint32_t i) {
+    ssd1306_draw_square(p, 0, 0, 128, 64);
+}
+
+static void unaligned_pixelwise(ssd1306_t *p, uint32_t i) {
+    fill_pixelwise(p, 3, 5, 100, 50);
+}
+
+static void unaligned_square(ssd1306_t *p, uint32_t i) {
+    ssd1306_draw_square(p, 3, 5, 100, 50);
+}
+
+static void unaligned_clear_square(ssd1306_t *p, uint32_t i) {
+    ssd1306_clear_square(p, 3, 5, 100, 50);
+}
+
+static void hline(ssd1306_t *p, uint32_t i) {
+    ssd1306_draw_line(p, 0, i&63, 127, i&63);
+}
+
+static void vline(ssd1306_t *p, uint32_t i) {
+    ssd1306_draw_line(p, i&127, 0, i&127, 63);
+}
+
+static void random_line(ssd1306_t *p, uint32_t i) {
+    uint32_t r=i*2654435761u;
+    ssd1306_draw_line(p, r&127, (r>>7)&63, (r>>13)&127, (r>>20)&63);
+}
+
+static void clipped_line(ssd1306_t *p, uint32_t i) {
+    uint32_t r=i*2654435761u;
+    ssd1306_draw_line(p, (int32_t) (r&511)-192, (int32_t) ((r>>9)&255)-96, (int32_t) ((r>>17)&511)-192, 200);
+}
+
+static const char text_line[]="The quick brown fox jumps";
+
+// fills the screen with lines of text, like a text page at the given scale
+static void text_page(ssd1306_t *p, uint32_t scale) {
+    for(uint32_t y=0; y<64; y+=8*scale)
+        ssd1306_draw_string_with_font(p, 0, y, scale, font_8x5, text_line);
+}
+
+static void text_page1(ssd1306_t *p, uint32_t i) {
+    text_page(p, 1);
+}
+
+static void text_page2(ssd1306_t *p, uint32_t i) {
+    text_page(p, 2);
+}
+
+static void text_page3(ssd1306_t *p, uint32_t i) {
+    text_page(p, 3);
+}
+
+// the scale 1 text page drawn from the font descriptor of the same font
+static void text_page_descriptor(ssd1306_t *p, uint32_t i) {
+    for(uint32_t y=0; y<64; y+=8)
+        ssd1306_draw_text(p, 0, y, 1, &basic_font, text_line);
+}
+
+// glyphs of basic_font spread over sparse code points from U+4E00 on, like a font with a few
+// hundred CJK glyphs, and text_line spelled with them
+#define SPARSE_GLYPHS 1024
+static ssd1306_glyph_t sparse_glyphs[SPARSE_GLYPHS];
+static uint32_t sparse_codepoints[SPARSE_GLYPHS];
+static ssd1306_font_t sparse_font;
+static char sparse_line[3*sizeof(text_line)];
+
+static void make_sparse_font(void) {
+    const uint32_t dense=basic_font.last-basic_font.first+1;
+
+    for(uint32_t i=0; i<SPARSE_GLYPHS; ++i) {
+        sparse_glyphs[i]=basic_font.glyphs[i%dense];
+        sparse_codepoints[i]=0x4e00+3*i;
+    }
+    sparse_font=(ssd1306_font_t) {
+        .height=basic_font.height,
+        .first=1,
+        .last=0,
+        .glyphs=sparse_glyphs,
+        .bitmap=basic_font.bitmap,
+        .codepoints=sparse_codepoints,
+        .sparse=SPARSE_GLYPHS,
+    };
+
+    // code points U+4E00 to U+5BFD take three bytes in utf-8
+    char *d=sparse_line;
+    for(const char *c=text_line; *c; ++c) {
+        const uint32_t cp=0x4e00+3*(uint32_t) (*c-basic_font.first);
+        *d++=(char) (0xe0|cp>>12);
+        *d++=(char) (0x80|(cp>>6&0x3f));
+        *d++=(char) (0x80|(cp&0x3f));
+    }
+    *d=0;
+}
+
+static volatile uint32_t text_width_sink;
+
+// glyph lookup alone, text_width does nothing but decode, look up and add
+static void text_width_dense(ssd1306_t *p, uint32_t i) {
+    text_width_sink=ssd1306_text_width(&basic_font, 1, text_line);
+}
+
+static void text_width_sparse(ssd1306_t *p, uint32_t i) {
+    text_width_sink=ssd1306_text_width(&sparse_font, 1, sparse_line);
+}
+
+static void text_page_sparse(ssd1306_t *p, uint32_t i) {
+    for(uint32_t y=0; y<64; y+=8)
+        ssd1306_draw_text(p, 0, y, 1, &sparse_font, sparse_line);
+}
+
+// 16x16 page-major icon
+static const uint8_t icon[32]= {
+    0x00, 0x00, 0xf0, 0x08, 0x04, 0x02, 0x22, 0x02, 0x02, 0x22, 0x02, 0x04, 0x08, 0xf0, 0x00, 0x00,
+    0x00, 0x00, 0x0f, 0x10, 0x20, 0x42, 0x44, 0x48, 0x48, 0x44, 0x42, 0x20, 0x10, 0x0f, 0x00, 0x00,
+};
+
+static void icon_pixelwise(ssd1306_t *p, uint32_t i) {
+    const uint32_t x0=(i*17)&111, y0=(i*5)&47;
+    for(uint32_t x=0; x<16; ++x)
+        for(uint32_t y=0; y<16; ++y)
+            if(icon[(y>>3)*16+x]>>(y&7)&1)
+                ssd1306_draw_pixel(p, x0+x, y0+y);
+}
+
+static void icon_blit_aligned(ssd1306_t *p, uint32_t i) {
+    ssd1306_blit(p, (const char *) icon, 16, 16, (i*17)&111, (i*8)&47);
+}
+
+static void icon_blit(ssd1306_t *p, uint32_t i) {
+    ssd1306_blit(p, (const char *) icon, 16, 16, (i*17)&111, (i*5)&47);
+}
+
+static void icon_blit_xor(ssd1306_t *p, uint32_t i) {
+    ssd1306_blit_mode(p, (const char *) icon, 16, 16, (i*17)&111, (i*5)&47, SSD1306_BLIT_XOR);
+}
+
+static void bmp_image(ssd1306_t *p, uint32_t i) {
+    ssd1306_bmp_show_image(p, image_data, image_size);
+}
+
+// the example bitmap in page format, filled in by main
+static uint8_t page_image[3+128*64/8];
+
+static void page_image_aligned(ssd1306_t *p, uint32_t i) {
+    ssd1306_draw_image(p, page_image, 0, 0);
+}
+
+static void page_image_unaligned(ssd1306_t *p, uint32_t i) {
+    ssd1306_draw_image(p, page_image, 0, 3);
+}
+
+static void rle_image_aligned(ssd1306_t *p, uint32_t i) {
+    ssd1306_draw_image(p, test_bmp_data, 0, 0);
+}
+
+static void rle_image_unaligned(ssd1306_t *p, uint32_t i) {
+    ssd1306_draw_image(p, test_bmp_data, 0, 3);
+}
+
+static void clear_screen(ssd1306_t *p, uint32_t i) {
+    ssd1306_clear(p);
+}
+
+static void pixel(ssd1306_t *p, uint32_t i) {
+    ssd1306_draw_pixel(p, (i*17)&127, (i*5)&63);
+}
+
+static const bench_t benches[]= {
+    {"fill screen pixelwise", screen_pixelwise, 128*64},
+    {"fill screen square", screen_square, 128*64},
+    {"fill 100x50 pixelwise", unaligned_pixelwise, 100*50},
+    {"fill 100x50 square", unaligned_square, 100*50},
+    {"clear 100x50 square", unaligned_clear_square, 100*50},
+    {"horizontal line", hline, 128},
+    {"vertical line", vline, 64},
+    {"random line", random_line, 0},
+    {"clipped line", clipped_line, 0},
+    {"icon 16x16 pixelwise", icon_pixelwise, 16*16},
+    {"icon 16x16 blit aligned", icon_blit_aligned, 16*16},
+    {"icon 16x16 blit", icon_blit, 16*16},
+    {"icon 16x16 blit xor", icon_blit_xor, 16*16},
+    {"bmp image", bmp_image, 128*64},
+    {"page image aligned", page_image_aligned, 128*64},
+    {"page image unaligned", page_image_unaligned, 128*61},
+    {"rle image aligned", rle_image_aligned, 128*64},
+    {"rle image unaligned", rle_image_unaligned, 128*61},
+    {"text page scale 1", text_page1, 128*64},
+    {"text page scale 2", text_page2, 128*64},
+    {"text page scale 3", text_page3, 128*64},
+    {"text page descriptor", text_page_descriptor, 128*64},
+    {"text page sparse utf-8", text_page_sparse, 128*64},
+    {"text width dense", text_width_dense, 0},
+    {"text width sparse utf-8", text_width_sparse, 0},
+    {"clear and show", clear_screen, 128*64, true},
+    {"pixel and show", pixel, 1, true},
+};
+
+typedef struct {
+    uint32_t iterations;
+    double ns_per_op;
+    double pixels_per_s;	/**< 0 if the pixels per call vary */
+    size_t show_bytes;		/**< buffer bytes the next show sends after a single call */
+    size_t bus_bytes;		/**< bytes that show puts on the bus, including commands and control bytes */
+} result_t;
+
+static size_t bus_bytes(void) {
+#ifdef BENCH_PICO
+    return 0;
+#else
+    return i2c1->bytes;
+#endif
+}
+
+static result_t measure(ssd1306_t *p, const bench_t *b) {
+    result_t r= {0};
+    double start=now(), elapsed;
+
+    do {
+        for(uint32_t i=0; i<BATCH; ++i) {
+            b->run(p, r.iterations+i);
+            if(b->show)
+                ssd1306_show(p);
+        }
+        r.iterations+=BATCH;
+    } while((elapsed=now()-start)<MIN_SECONDS);
+
+    r.ns_per_op=elapsed*1e9/r.iterations;
+    r.pixels_per_s=b->pixels*(double) r.iterations/elapsed;
+
+    // what a show costs after one call on a display that is up to date
+    ssd1306_show(p);
+    b->run(p, 1);
+    const size_t before=bus_bytes();
+    ssd1306_show(p);
+    r.show_bytes=p->flush_bytes;
+    r.bus_bytes=bus_bytes()-before;
+
+    return r;
+}
+
+int main(int argc, char **argv) {
+    ssd1306_t disp;
+#ifdef BENCH_PICO
+    const bool csv=true;
+
+    stdio_init_all();
+    i2c_init(i2c1, 400000);
+    gpio_set_function(2, GPIO_FUNC_I2C);
+    gpio_set_function(3, GPIO_FUNC_I2C);
+    gpio_pull_up(2);
+    gpio_pull_up(3);
+    // give the usb serial time to connect
+    sleep_ms(3000);
+#else
+    const bool csv=argc>1 && strcmp(argv[1], "-c")==0;
+#endif
+
+    disp.external_vcc=false;
+    if(!ssd1306_init(&disp, 128, 64, 0x3C, i2c1)) {
+        fprintf(stderr, "could not initialize display\n");
+        return EXIT_FAILURE;
+    }
+
+    ssd1306_clear(&disp);
+    ssd1306_bmp_show_image(&disp, image_data, image_size);
+    page_image[0]=128;
+    page_image[1]=64;
+    page_image[2]=SSD1306_IMAGE_PAGES;
+    memcpy(page_image+3, disp.buffer, disp.bufsize);
+    make_sparse_font();
+
+    if(csv)
+        printf("name,iterations,ns_per_op,pixels_per_s,show_bytes,bus_bytes\n");
+
+    for(size_t b=0; b<sizeof(benches)/sizeof(benches[0]); ++b) {
+        const result_t r=measure(&disp, &benches[b]);
+
+        if(csv) {
+            printf("%s,%lu,%.1f,%.0f,%zu,%zu\n", benches[b].name, (unsigned long) r.iterations, r.ns_per_op,
+                   r.pixels_per_s, r.show_bytes, r.bus_bytes);
+            continue;
+        }
+
+        printf("%-28s %12.1f ns/op", benches[b].name, r.ns_per_op);
+        if(r.pixels_per_s)
+            printf(" %12.2f Mpixel/s", r.pixels_per_s*1e-6);
+        else
+            printf(" %21s", "");
+        printf(" %6zu bytes/show\n", r.bus_bytes ? r.bus_bytes : r.show_bytes);
+    }
+
+    ssd1306_deinit(&disp);
+    return EXIT_SUCCESS;
+}
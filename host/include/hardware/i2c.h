@@ -0,0 +1,20 @@
+/*
+ * minimal stand-in for the pico-sdk header, used to build the library on the host
+ */
+#ifndef _host_hardware_i2c_h
+#define _host_hardware_i2c_h
+#include "pico/stdlib.h"
+
+struct ssd1306_emu;
+
+typedef struct {
+    size_t bytes;		/**< bytes written to the bus */
+    size_t transactions;	/**< number of i2c transactions */
+    struct ssd1306_emu *devices;	/**< emulated devices on the bus, every address is acknowledged if there is none */
+} i2c_inst_t;
+
+extern i2c_inst_t *i2c0, *i2c1;
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+
+#endif
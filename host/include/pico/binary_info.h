@@ -0,0 +1,6 @@
+/*
+ * minimal stand-in for the pico-sdk header, used to build the library on the host
+ */
+#ifndef _host_pico_binary_info_h
+#define _host_pico_binary_info_h
+#endif
@@ -0,0 +1,18 @@
+/*
+ * minimal stand-in for the pico-sdk header, used to build the library on the host
+ */
+#ifndef _host_pico_stdlib_h
+#define _host_pico_stdlib_h
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+
+#define PICO_OK 0
+#define PICO_ERROR_GENERIC -1
+#define PICO_ERROR_TIMEOUT -2
+
+static inline void tight_loop_contents(void) {}
+
+#endif
@@ -0,0 +1,148 @@
+/*
+ * drives the frame pool of ssd1306_queue.h from a producer and a consumer thread
+ *
+ * build with `make` and run `./queue_test`, every policy is checked for ordering, torn frames,
+ * dropped and coalesced frames and the counters of the pool
+ */
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+// waiting for free frames or the lock yields, host threads may share a single cpu
+#define SSD1306_QUEUE_IDLE() std::this_thread::yield()
+#include "ssd1306_queue.h"
+
+#define FRAME_SIZE 1024
+#define FRAME_COUNT 4
+
+static uint8_t frames[FRAME_COUNT][FRAME_SIZE];
+
+struct result_t {
+    uint32_t submitted;		// frames queued by the producer
+    uint32_t last_submitted;	// sequence number of the last queued frame
+    uint32_t taken;		// frames seen by the consumer
+    uint32_t last_taken;	// sequence number of the last frame seen
+    uint32_t errors;
+};
+
+// every byte of a frame holds the low byte of its sequence number, the first four the whole number
+static void draw(uint8_t *frame, uint32_t seq) {
+    memset(frame, seq&0xff, FRAME_SIZE);
+    memcpy(frame, &seq, sizeof(seq));
+}
+
+static bool check(const uint8_t *frame, uint32_t *seq) {
+    memcpy(seq, frame, sizeof(*seq));
+    for(size_t i=sizeof(*seq); i<FRAME_SIZE; ++i)
+        if(frame[i]!=(*seq&0xff))
+            return false;
+    return true;
+}
+
+static void produce(ssd1306_frame_pool_t *pool, uint32_t n, result_t *r, std::atomic<bool> *done) {
+    uint8_t *frame=ssd1306_frame_pool_current(pool);
+
+    for(uint32_t seq=1; seq<=n; ++seq) {
+        draw(frame, seq);
+        uint8_t *next=ssd1306_frame_pool_submit(pool);
+        // a dropped frame is handed back
+        if(next!=frame) {
+            ++r->submitted;
+            r->last_submitted=seq;
+        }
+        frame=next;
+        // drawing takes a while, the consumer gets a chance to run
+        std::this_thread::yield();
+    }
+
+    done->store(true, std::memory_order_release);
+}
+
+static void consume(ssd1306_frame_pool_t *pool, result_t *r, std::atomic<bool> *done, bool slow) {
+    for(;;) {
+        // the flag has to be read before the last take, frames queued before it are still seen
+        const bool finished=done->load(std::memory_order_acquire);
+        const int index=ssd1306_frame_pool_take(pool);
+
+        if(index<0) {
+            if(finished)
+                break;
+            std::this_thread::yield();
+            continue;
+        }
+
+        uint32_t seq;
+        if(!check(pool->frames[index], &seq)) {
+            fprintf(stderr, "frame %u torn\n", seq);
+            ++r->errors;
+        }
+        if(seq<=r->last_taken) {
+            fprintf(stderr, "frame %u after frame %u\n", seq, r->last_taken);
+            ++r->errors;
+        }
+        r->last_taken=seq;
+        ++r->taken;
+
+        // a display that falls behind
+        if(slow && (r->taken&3)==0)
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        ssd1306_frame_pool_release(pool, index);
+    }
+}
+
+static bool run(const char *name, ssd1306_queue_policy_t policy, uint32_t n, bool slow) {
+    ssd1306_frame_pool_t pool;
+    result_t produced= {}, consumed= {};
+    std::atomic<bool> done(false);
+
+    if(!ssd1306_frame_pool_init(&pool, frames[0], FRAME_SIZE, FRAME_COUNT, policy)) {
+        printf("%s: init failed\n", name);
+        return false;
+    }
+
+    std::thread consumer(consume, &pool, &consumed, &done, slow);
+    std::thread producer(produce, &pool, n, &produced, &done);
+    producer.join();
+    consumer.join();
+
+    uint32_t errors=consumed.errors;
+    // every queued frame is presented or, with SSD1306_QUEUE_LATEST, skipped for a newer one
+    if(produced.submitted+pool.dropped!=n)
+        ++errors;
+    if(pool.presented!=consumed.taken || pool.presented+pool.coalesced!=produced.submitted)
+        ++errors;
+
+    switch(policy) {
+    case SSD1306_QUEUE_WAIT:
+        if(pool.dropped || pool.coalesced || consumed.taken!=n)
+            ++errors;
+        break;
+    case SSD1306_QUEUE_DROP:
+        // the newest queued frame reaches the display
+        if(pool.coalesced || (slow && pool.dropped==0) || consumed.last_taken!=produced.last_submitted)
+            ++errors;
+        break;
+    case SSD1306_QUEUE_LATEST:
+        // nothing is dropped, the producer takes back queued frames instead and the last frame is shown
+        if(pool.dropped || (slow && pool.coalesced==0) || consumed.last_taken!=n)
+            ++errors;
+        break;
+    }
+
+    printf("%-8s frames=%u submitted=%u presented=%u dropped=%u coalesced=%u last=%u errors=%u\n",
+           name, n, produced.submitted, pool.presented, pool.dropped, pool.coalesced, consumed.last_taken, errors);
+    return errors==0;
+}
+
+int main() {
+    bool ok=true;
+
+    ok&=run("wait", SSD1306_QUEUE_WAIT, 200000, false);
+    ok&=run("drop", SSD1306_QUEUE_DROP, 100000, true);
+    ok&=run("latest", SSD1306_QUEUE_LATEST, 100000, true);
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,135 @@
+/*
+ * draws a few frames through the emulated display and writes what the panel shows, the same
+ * frames drawn through ssd1306_memory_transport have to leave the same display ram behind
+ *
+ * build with `make` and run `./render [prefix]`, frames are written to <prefix>N.pbm
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "ssd1306.h"
+#include "ssd1306_emu.h"
+#include "font.h"
+#include "image.h"
+
+static ssd1306_emu_t emu;
+static ssd1306_memory_t mem;
+
+// bytes of the display ram that differ between the emulator and the memory transport
+static size_t ram_mismatches(void) {
+    size_t mismatches=0;
+    for(uint32_t page=0; page<8; ++page)
+        for(uint32_t x=0; x<128; ++x)
+            mismatches+=emu.ram[page][x]!=mem.ram[page][x];
+    return mismatches;
+}
+
+// draws frame n of the sequence
+static void draw(ssd1306_t *p, int n) {
+    switch(n) {
+    case 0:
+        ssd1306_clear(p);
+        ssd1306_bmp_show_image(p, image_data, image_size);
+        break;
+    case 1:
+        ssd1306_clear(p);
+        ssd1306_draw_string_with_font(p, 8, 4, 2, font_8x5, "SSD1306");
+        ssd1306_draw_string_with_font(p, 8, 28, 1, font_8x5, "host emulator");
+        ssd1306_draw_empty_square(p, 0, 0, 127, 63);
+        break;
+    case 2:
+        ssd1306_draw_line(p, 0, 63, 127, 40);
+        break;
+    case 3:
+        ssd1306_draw_pixel(p, 100, 50);
+        break;
+    }
+}
+
+// shows the display buffer and reports what the show cost on the bus
+static bool frame(ssd1306_t *p, ssd1306_t *m, const char *prefix, int n, const char *name) {
+    char path[256];
+
+    draw(p, n);
+    draw(m, n);
+    ssd1306_emu_reset_counters(&emu);
+    ssd1306_show(p);
+    ssd1306_show(m);
+
+    // every pixel of the panel has to match the display buffer
+    size_t mismatches=0;
+    for(uint32_t y=0; y<p->height; ++y)
+        for(uint32_t x=0; x<p->width; ++x)
+            mismatches+=ssd1306_emu_pixel(&emu, x, y)!=(bool) (p->buffer[(y>>3)*p->width+x]>>(y&7)&1);
+
+    mismatches+=ram_mismatches();
+
+    snprintf(path, sizeof(path), "%s%d.pbm", prefix, n);
+    printf("frame=%d name=\"%s\" bytes=%zu transactions=%zu command_bytes=%zu data_bytes=%zu mismatches=%zu\n",
+           n, name, emu.bytes, emu.transactions, emu.command_bytes, emu.data_bytes, mismatches);
+
+    return ssd1306_emu_write_pbm(&emu, path) && mismatches==0;
+}
+
+// writes lines to the console until it has scrolled and reports what the last line cost
+static bool console(ssd1306_t *p, ssd1306_t *m, const char *prefix, int n) {
+    ssd1306_console_t c, cm;
+    char path[256], line[32];
+
+    if(!ssd1306_console_init(&c, p, font_8x5, 1) || !ssd1306_console_init(&cm, m, font_8x5, 1))
+        return false;
+
+    for(int i=0; i<=c.rows; ++i) {
+        snprintf(line, sizeof(line), "\nline %d", i);
+        ssd1306_emu_reset_counters(&emu);
+        ssd1306_console_write(&c, line);
+        ssd1306_console_write(&cm, line);
+    }
+
+    // the top of the panel shows the display ram from the start line on
+    size_t mismatches=0;
+    for(uint32_t y=0; y<p->height; ++y) {
+        const uint32_t row=c.ring ? (y+(c.top<<3))&63 : y;
+        for(uint32_t x=0; x<p->width; ++x)
+            mismatches+=ssd1306_emu_pixel(&emu, x, y)!=(bool) (p->buffer[(row>>3)*p->width+x]>>(row&7)&1);
+    }
+    mismatches+=ram_mismatches();
+
+    snprintf(path, sizeof(path), "%s%d.pbm", prefix, n);
+    printf("frame=%d name=\"console\" bytes=%zu transactions=%zu command_bytes=%zu data_bytes=%zu mismatches=%zu\n",
+           n, emu.bytes, emu.transactions, emu.command_bytes, emu.data_bytes, mismatches);
+
+    return ssd1306_emu_write_pbm(&emu, path) && mismatches==0;
+}
+
+int main(int argc, char **argv) {
+    const char *prefix=argc>1 ? argv[1] : "frame";
+    bool ok=true;
+    int n=0;
+    ssd1306_t disp, mem_disp;
+
+    ssd1306_emu_attach(&emu, i2c1, 0x3C, 128, 64);
+    disp.external_vcc=false;
+    if(!ssd1306_init(&disp, 128, 64, 0x3C, i2c1)) {
+        fprintf(stderr, "could not initialize display\n");
+        return EXIT_FAILURE;
+    }
+    printf("init bytes=%zu transactions=%zu unknown=%zu\n", emu.bytes, emu.transactions, emu.unknown);
+
+    mem_disp.external_vcc=false;
+    if(!ssd1306_init_transport(&mem_disp, 128, 64, &ssd1306_memory_transport, &mem)) {
+        fprintf(stderr, "could not initialize memory display\n");
+        return EXIT_FAILURE;
+    }
+
+    ok&=frame(&disp, &mem_disp, prefix, n++, "image");
+    ok&=frame(&disp, &mem_disp, prefix, n++, "text");
+    ok&=frame(&disp, &mem_disp, prefix, n++, "line");
+    ok&=frame(&disp, &mem_disp, prefix, n++, "pixel");
+    ok&=console(&disp, &mem_disp, prefix, n++);
+
+    ssd1306_deinit(&mem_disp);
+    ssd1306_deinit(&disp);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
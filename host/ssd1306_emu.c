@@ -0,0 +1,294 @@
+#include <string.h>
+
+#include "ssd1306_emu.h"
+
+void ssd1306_emu_attach(ssd1306_emu_t *e, i2c_inst_t *i2c, uint8_t address, uint8_t width, uint8_t height) {
+    memset(e, 0, sizeof(*e));
+    e->address=address;
+    e->width=width;
+    e->height=height;
+    e->col_offset=width==64?32:0;
+
+    // reset values of the controller
+    e->mode=SSD1306_EMU_PAGE;
+    e->col1=127;
+    e->page1=7;
+    e->mux=64;
+    e->contrast=0x7f;
+    e->scroll_rows=64;
+
+    e->next=i2c->devices;
+    i2c->devices=e;
+}
+
+void ssd1306_emu_reset_counters(ssd1306_emu_t *e) {
+    e->bytes=0;
+    e->command_bytes=0;
+    e->data_bytes=0;
+    e->transactions=0;
+    e->scroll_writes=0;
+    e->unknown=0;
+}
+
+// number of argument bytes following a command, -1 if the command is unknown
+static int ssd1306_emu_args(uint8_t cmd) {
+    if(cmd<=0x1f || (cmd>=0x40 && cmd<=0x7f) || (cmd>=0xb0 && cmd<=0xb7))
+        return 0;
+
+    switch(cmd) {
+    case 0x26: // horizontal scroll
+    case 0x27:
+        return 6;
+    case 0x29: // vertical and horizontal scroll
+    case 0x2a:
+        return 5;
+    case 0x21: // column address
+    case 0x22: // page address
+    case 0xa3: // vertical scroll area
+        return 2;
+    case 0x20: // memory addressing mode
+    case 0x23: // fade out and blinking
+    case 0x81: // contrast
+    case 0x8d: // charge pump
+    case 0xa8: // multiplex ratio
+    case 0xd3: // display offset
+    case 0xd5: // clock divide
+    case 0xd6: // zoom in
+    case 0xd9: // pre-charge period
+    case 0xda: // com pins
+    case 0xdb: // vcomh deselect level
+        return 1;
+    case 0x2e: // deactivate scroll
+    case 0x2f: // activate scroll
+    case 0xa0: // segment remap
+    case 0xa1:
+    case 0xa4: // entire display on
+    case 0xa5:
+    case 0xa6: // normal / inverse
+    case 0xa7:
+    case 0xae: // display off / on
+    case 0xaf:
+    case 0xc0: // com output scan direction
+    case 0xc8:
+    case 0xe3: // nop
+        return 0;
+    default:
+        return -1;
+    }
+}
+
+// carries out the command once all of its arguments have arrived
+static void ssd1306_emu_execute(ssd1306_emu_t *e) {
+    const uint8_t cmd=e->command, *arg=e->arg;
+
+    if(cmd<=0x0f) {
+        e->page_col=(e->page_col&0xf0)|cmd;
+        e->col=e->page_col;
+    } else if(cmd<=0x1f) {
+        e->page_col=(uint8_t) (((cmd&0x07)<<4)|(e->page_col&0x0f));
+        e->col=e->page_col;
+    } else if(cmd>=0x40 && cmd<=0x7f) {
+        e->start_line=cmd&0x3f;
+    } else if(cmd>=0xb0 && cmd<=0xb7) {
+        e->page=cmd&0x07;
+    } else {
+        switch(cmd) {
+        case 0x20:
+            e->mode=(arg[0]&3)==3 ? SSD1306_EMU_PAGE : (ssd1306_emu_mode_t) (arg[0]&3);
+            break;
+        case 0x21:
+            e->col0=e->col=arg[0]&0x7f;
+            e->col1=arg[1]&0x7f;
+            break;
+        case 0x22:
+            e->page0=e->page=arg[0]&0x07;
+            e->page1=arg[1]&0x07;
+            break;
+        case 0x26:
+        case 0x27:
+        case 0x29:
+        case 0x2a:
+            e->scroll_cmd=cmd;
+            e->scroll_page0=arg[1]&0x07;
+            e->scroll_page1=arg[3]&0x07;
+            e->scroll_vertical=cmd>=0x29 ? arg[4]&0x3f : 0;
+            e->scroll_line=0;
+            break;
+        case 0xa3:
+            e->scroll_fixed=arg[0]&0x3f;
+            e->scroll_rows=arg[1]&0x7f;
+            break;
+        case 0x2e:
+            e->scrolling=false;
+            e->scroll_line=0;
+            break;
+        case 0x2f:
+            e->scrolling=e->scroll_cmd!=0;
+            break;
+        case 0x81:
+            e->contrast=arg[0];
+            break;
+        case 0xa8:
+            e->mux=(arg[0]&0x3f)+1;
+            break;
+        case 0xd3:
+            e->offset=arg[0]&0x3f;
+            break;
+        case 0xa0:
+        case 0xa1:
+            e->remap=cmd&1;
+            break;
+        case 0xa4:
+        case 0xa5:
+            e->entire_on=cmd&1;
+            break;
+        case 0xa6:
+        case 0xa7:
+            e->inverted=cmd&1;
+            break;
+        case 0xae:
+        case 0xaf:
+            e->on=cmd&1;
+            break;
+        case 0xc0:
+        case 0xc8:
+            e->com_reverse=cmd==0xc8;
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+static void ssd1306_emu_command(ssd1306_emu_t *e, uint8_t b) {
+    ++e->command_bytes;
+
+    if(e->args) {
+        if(e->arg_count<sizeof(e->arg))
+            e->arg[e->arg_count++]=b;
+        if(--e->args==0)
+            ssd1306_emu_execute(e);
+        return;
+    }
+
+    const int args=ssd1306_emu_args(b);
+    if(args<0) {
+        ++e->unknown;
+        return;
+    }
+
+    e->command=b;
+    e->arg_count=0;
+    e->args=(uint8_t) args;
+    if(args==0)
+        ssd1306_emu_execute(e);
+}
+
+// stores the byte and advances the address like the addressing mode does
+static void ssd1306_emu_data(ssd1306_emu_t *e, uint8_t b) {
+    ++e->data_bytes;
+    if(e->scrolling)
+        ++e->scroll_writes;
+
+    e->ram[e->page][e->col]=b;
+
+    switch(e->mode) {
+    case SSD1306_EMU_HORIZONTAL:
+        if(e->col!=e->col1) {
+            e->col=(e->col+1)&0x7f;
+        } else {
+            e->col=e->col0;
+            e->page=e->page==e->page1 ? e->page0 : (e->page+1)&0x07;
+        }
+        break;
+    case SSD1306_EMU_VERTICAL:
+        if(e->page!=e->page1) {
+            e->page=(e->page+1)&0x07;
+        } else {
+            e->page=e->page0;
+            e->col=e->col==e->col1 ? e->col0 : (e->col+1)&0x7f;
+        }
+        break;
+    case SSD1306_EMU_PAGE:
+        e->col=e->col==127 ? e->page_col : e->col+1;
+        break;
+    }
+}
+
+void ssd1306_emu_write(ssd1306_emu_t *e, const uint8_t *src, size_t len) {
+    e->bytes+=len;
+    ++e->transactions;
+
+    for(size_t i=0; i<len;) {
+        const uint8_t control=src[i++];
+        const bool data=control&0x40;
+
+        // with the continuation bit set, a single byte follows before the next control byte
+        const size_t end=control&0x80 ? (i+1<len ? i+1 : len) : len;
+        for(; i<end; ++i) {
+            if(data)
+                ssd1306_emu_data(e, src[i]);
+            else
+                ssd1306_emu_command(e, src[i]);
+        }
+    }
+}
+
+// moves the columns of the scrolled pages by one, like one step of the scroll timer
+static void ssd1306_emu_rotate(ssd1306_emu_t *e, bool right) {
+    for(uint32_t page=e->scroll_page0; page<=e->scroll_page1 && page<8; ++page) {
+        uint8_t *row=e->ram[page];
+        if(right) {
+            const uint8_t last=row[127];
+            memmove(row+1, row, 127);
+            row[0]=last;
+        } else {
+            const uint8_t first=row[0];
+            memmove(row, row+1, 127);
+            row[127]=first;
+        }
+    }
+}
+
+void ssd1306_emu_step(ssd1306_emu_t *e) {
+    if(!e->scrolling)
+        return;
+
+    ssd1306_emu_rotate(e, e->scroll_cmd==0x26 || e->scroll_cmd==0x29);
+    if(e->scroll_vertical && e->scroll_rows)
+        e->scroll_line=(e->scroll_line+e->scroll_vertical)%e->scroll_rows;
+}
+
+bool ssd1306_emu_pixel(const ssd1306_emu_t *e, uint32_t x, uint32_t y) {
+    if(!e->on || x>=e->width || y>=e->height || y>=e->mux)
+        return false;
+
+    // com line driving the row, the panel is mounted for a reversed scan
+    uint32_t line=e->com_reverse ? y : e->mux-1-y;
+
+    if(e->scrolling && e->scroll_vertical && line>=e->scroll_fixed && line<(uint32_t) e->scroll_fixed+e->scroll_rows)
+        line=e->scroll_fixed+(line-e->scroll_fixed+e->scroll_line)%e->scroll_rows;
+
+    const uint32_t row=(line+e->start_line+e->offset)&63;
+    const uint32_t seg=x+e->col_offset;
+    const uint32_t col=e->remap ? seg : 127-seg;
+
+    const bool lit=e->entire_on || (e->ram[row>>3][col]>>(row&7)&1);
+    return lit!=e->inverted;
+}
+
+bool ssd1306_emu_write_pbm(const ssd1306_emu_t *e, const char *path) {
+    FILE *f=fopen(path, "w");
+    if(f==NULL)
+        return false;
+
+    // lit pixels are written as 1, which pbm viewers show black
+    fprintf(f, "P1\n%u %u\n", e->width, e->height);
+    for(uint32_t y=0; y<e->height; ++y) {
+        for(uint32_t x=0; x<e->width; ++x)
+            fputc(ssd1306_emu_pixel(e, x, y) ? '1' : '0', f);
+        fputc('\n', f);
+    }
+
+    return fclose(f)==0;
+}
@@ -0,0 +1,112 @@
+/*
+ * emulator of the ssd1306 command stream, fed by the i2c stand-in of the host build
+ */
+#ifndef _host_ssd1306_emu_h
+#define _host_ssd1306_emu_h
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "hardware/i2c.h"
+
+/**
+*	@brief memory addressing mode selected by command 0x20
+*/
+typedef enum {
+    SSD1306_EMU_HORIZONTAL=0,
+    SSD1306_EMU_VERTICAL=1,
+    SSD1306_EMU_PAGE=2,
+} ssd1306_emu_mode_t;
+
+/**
+*	@brief one emulated controller and the panel connected to it
+*
+*	The panel is mounted the way ssd1306_init expects it: with segment
+*	remap and reversed com scan the display buffer shows upright, without
+*	either the picture is mirrored.
+*/
+typedef struct ssd1306_emu {
+    struct ssd1306_emu *next;	/**< next device on the same bus */
+    uint8_t address;		/**< i2c address */
+    uint8_t width;		/**< panel width */
+    uint8_t height;		/**< panel height */
+    uint8_t col_offset;		/**< first gddram column of the panel, 32 for 64 pixel wide panels */
+
+    uint8_t ram[8][128];	/**< gddram, page by page */
+    ssd1306_emu_mode_t mode;	/**< memory addressing mode */
+    uint8_t col0, col1;		/**< column window of horizontal and vertical mode */
+    uint8_t page0, page1;	/**< page window of horizontal and vertical mode */
+    uint8_t col, page;		/**< address of the next data byte */
+    uint8_t page_col;		/**< start column of page mode */
+
+    uint8_t start_line;		/**< ram row shown on the first com line */
+    uint8_t offset;		/**< vertical display offset */
+    uint8_t mux;		/**< number of com lines */
+    uint8_t contrast;		/**< contrast */
+    bool remap;			/**< segment remap, column 127 is the leftmost segment */
+    bool com_reverse;		/**< com lines are scanned from the last to the first */
+    bool inverted;		/**< inverted display */
+    bool entire_on;		/**< all pixels on regardless of the ram */
+    bool on;			/**< display on */
+
+    uint8_t scroll_cmd;		/**< last scroll setup command, 0 if none */
+    uint8_t scroll_page0, scroll_page1;	/**< pages moved by the horizontal scroll */
+    uint8_t scroll_vertical;	/**< rows the vertical scroll moves per step */
+    uint8_t scroll_fixed;	/**< rows above the vertical scroll area */
+    uint8_t scroll_rows;	/**< rows of the vertical scroll area */
+    uint8_t scroll_line;	/**< current vertical scroll offset */
+    bool scrolling;		/**< scroll activated */
+
+    uint8_t command;		/**< command whose arguments are being received */
+    uint8_t args;		/**< arguments of command still to come */
+    uint8_t arg_count;		/**< arguments of command received */
+    uint8_t arg[6];		/**< arguments of command */
+
+    size_t bytes;		/**< bytes received, including control bytes */
+    size_t command_bytes;	/**< command bytes received */
+    size_t data_bytes;		/**< data bytes received */
+    size_t transactions;	/**< i2c transactions addressed to the device */
+    size_t scroll_writes;	/**< data bytes received while scrolling, the datasheet leaves their effect undefined */
+    size_t unknown;		/**< command bytes not understood */
+} ssd1306_emu_t;
+
+/**
+*	@brief set up emulator and connect it to bus
+*
+*	@param[in] e : emulator
+*	@param[in] i2c : bus the emulator listens on
+*	@param[in] address : i2c address
+*	@param[in] width : panel width, 128 or 64
+*	@param[in] height : panel height, 64, 48 or 32
+*/
+void ssd1306_emu_attach(ssd1306_emu_t *e, i2c_inst_t *i2c, uint8_t address, uint8_t width, uint8_t height);
+
+/**
+*	@brief feed one i2c transaction into the emulator, the first byte is the control byte
+*/
+void ssd1306_emu_write(ssd1306_emu_t *e, const uint8_t *src, size_t len);
+
+/**
+*	@brief advance an active scroll by one step
+*/
+void ssd1306_emu_step(ssd1306_emu_t *e);
+
+/**
+*	@brief state of the panel pixel as seen by the viewer
+*/
+bool ssd1306_emu_pixel(const ssd1306_emu_t *e, uint32_t x, uint32_t y);
+
+/**
+*	@brief write what the panel shows as plain pbm
+*
+*	@return false if the file could not be written
+*/
+bool ssd1306_emu_write_pbm(const ssd1306_emu_t *e, const char *path);
+
+/**
+*	@brief reset the byte and transaction counters
+*/
+void ssd1306_emu_reset_counters(ssd1306_emu_t *e);
+
+#endif
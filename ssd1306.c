@@ -33,43 +33,737 @@ SOFTWARE.
 #include "ssd1306.h"
 #ifdef SSD1306_USE_DMA
 #include "hardware/dma.h"
+#include "hardware/irq.h"
+#endif
+#ifdef SSD1306_USE_SPI
+#include "hardware/gpio.h"
+#endif
+#ifdef SSD1306_USE_PIPELINE
+#include "pico/multicore.h"
+#endif
+#if defined(SSD1306_USE_PIPELINE) || defined(SSD1306_USE_STATS)
+#include "hardware/sync.h"
 #endif
 #include "font_struct.h"
 
+#ifndef SSD1306_WINDOW_COST
+// unchanged bytes that are cheaper to resend than setting up another address window
+#define SSD1306_WINDOW_COST 16
+#endif
+
+#ifndef SSD1306_COMMAND_BATCH
+// command bytes sent per i2c transaction by ssd1306_write_commands
+#define SSD1306_COMMAND_BATCH 32
+#endif
+
+#ifndef SSD1306_CONSOLE_TAB
+// columns between two tab stops of the console
+#define SSD1306_CONSOLE_TAB 4
+#endif
+
+#ifdef SSD1306_FIXED_WIDTH
+// the geometry is known at compile time, so indexing and clipping fold into constants
+#define SSD1306_WIDTH(p) SSD1306_FIXED_WIDTH
+#define SSD1306_HEIGHT(p) SSD1306_FIXED_HEIGHT
+#define SSD1306_PAGES(p) (SSD1306_FIXED_HEIGHT/8)
+#else
+#define SSD1306_WIDTH(p) ((p)->width)
+#define SSD1306_HEIGHT(p) ((p)->height)
+#define SSD1306_PAGES(p) ((p)->pages)
+#endif
+
+// command bytes that select an address window
+#define SSD1306_WINDOW_COMMANDS 6
+
 inline static void swap(int32_t *a, int32_t *b) {
-    int32_t *t=a;
+    int32_t t=*a;
     *a=*b;
-    *b=*t;
+    *b=t;
+}
+
+#ifdef SSD1306_USE_STATS
+static inline void ssd1306_stats_error(ssd1306_t *p, int error) {
+    if(error==PICO_ERROR_TIMEOUT)
+        ++p->stats.timeouts;
+    else
+        ++p->stats.nacks;
+    p->stats.last_error=error;
+}
+
+static inline void ssd1306_stats_commands(ssd1306_t *p, size_t len) {
+    p->stats.command_bytes+=len;
+}
+
+static inline void ssd1306_stats_start(ssd1306_t *p) {
+    p->tx_start=time_us_32();
+    p->stats.command_bytes+=p->tx_windows*SSD1306_WINDOW_COMMANDS;
+    p->stats.data_bytes+=p->flush_bytes;
+}
+
+static inline void ssd1306_stats_done(ssd1306_t *p) {
+    if(p->tx_windows==0)
+        return;
+
+    const uint32_t us=time_us_32()-p->tx_start;
+    uint32_t bucket=0;
+    while(bucket<SSD1306_STATS_BUCKETS-1 && us>=(uint32_t) SSD1306_STATS_BUCKET_US<<bucket)
+        ++bucket;
+
+    ++p->stats.flushes;
+    ++p->stats.latency[bucket];
+}
+
+void ssd1306_stats_snapshot(ssd1306_t *p, ssd1306_stats_t *stats) {
+    // transfers finish in interrupts
+    const uint32_t status=save_and_disable_interrupts();
+    *stats=p->stats;
+    restore_interrupts(status);
+}
+
+void ssd1306_stats_reset(ssd1306_t *p) {
+    const uint32_t status=save_and_disable_interrupts();
+    memset(&p->stats, 0, sizeof(p->stats));
+    restore_interrupts(status);
+}
+#else
+static inline void ssd1306_stats_error(ssd1306_t *p, int error) {
+    (void) p;
+    (void) error;
+}
+
+static inline void ssd1306_stats_commands(ssd1306_t *p, size_t len) {
+    (void) p;
+    (void) len;
+}
+
+static inline void ssd1306_stats_start(ssd1306_t *p) {
+    (void) p;
 }
 
+static inline void ssd1306_stats_done(ssd1306_t *p) {
+    (void) p;
+}
+#endif
+
 #ifndef SSD1306_USE_DMA
-inline static void fancy_write(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, char *name) {
-    switch(i2c_write_blocking(i2c, addr, src, len, false)) {
+inline static int fancy_write(ssd1306_t *p, const uint8_t *src, size_t len, char *name) {
+    switch(i2c_write_blocking(p->i2c_i, p->address, src, len, false)) {
     case PICO_ERROR_GENERIC:
+        ssd1306_stats_error(p, PICO_ERROR_GENERIC);
         printf("[%s] addr not acknowledged!\n", name);
-        break;
+        return PICO_ERROR_GENERIC;
     case PICO_ERROR_TIMEOUT:
+        ssd1306_stats_error(p, PICO_ERROR_TIMEOUT);
         printf("[%s] timeout!\n", name);
-        break;
+        return PICO_ERROR_TIMEOUT;
     default:
         //printf("[%s] wrote successfully %lu bytes!\n", name, len);
-        break;
+        return PICO_OK;
     }
 }
 #endif
 
+void ssd1306_transport_done(ssd1306_t *p, int result) {
+    ssd1306_stats_done(p);
+    if(p->tx_callback!=NULL)
+        p->tx_callback(p->tx_ctx, result);
+}
+
+// waits until the bus of the display is no longer used by a transfer
+static void ssd1306_wait(ssd1306_t *p) {
+    if(p->transport->busy==NULL)
+        return;
+
+    while(p->transport->busy(p))
+        tight_loop_contents();
+}
+
+// fills cmds with the commands that select the window
+static void ssd1306_window_commands(ssd1306_t *p, const ssd1306_window_t *w, uint8_t cmds[SSD1306_WINDOW_COMMANDS]) {
+    // 64 pixel wide displays are connected to the columns in the middle of the display ram
+    const uint8_t offset=SSD1306_WIDTH(p)==64?32:0;
+
+    cmds[0]=SET_COL_ADDR;
+    cmds[1]=w->x0+offset;
+    cmds[2]=w->x1+offset;
+    cmds[3]=SET_PAGE_ADDR;
+    cmds[4]=w->page0;
+    cmds[5]=w->page1;
+}
+
+static const void *ssd1306_i2c_bus(ssd1306_t *p) {
+    return p->i2c_i;
+}
+
+// sends commands behind a single control byte of 0x00, long sequences are split into several transactions
+static int ssd1306_i2c_commands(ssd1306_t *p, const uint8_t *cmds, size_t len) {
+    uint8_t d[SSD1306_COMMAND_BATCH+1];
+    int result=PICO_OK;
+
+    d[0]=0x00;
+    while(len) {
+        size_t n=len<SSD1306_COMMAND_BATCH?len:SSD1306_COMMAND_BATCH;
+        memcpy(d+1, cmds, n);
 #ifdef SSD1306_USE_DMA
-inline static void ssd1306_write(ssd1306_t *p, uint8_t val) {
-    uint8_t d[2]= {0x00, val};
-    i2c_write_blocking(p->i2c_i, p->address, d, 2, true);
+        const int ret=i2c_write_blocking(p->i2c_i, p->address, d, n+1, false);
+        if(ret<0) {
+            ssd1306_stats_error(p, ret);
+            result=PICO_ERROR_GENERIC;
+        }
+#else
+        if(fancy_write(p, d, n+1, "ssd1306_write_commands")!=PICO_OK)
+            result=PICO_ERROR_GENERIC;
+#endif
+        cmds+=n;
+        len-=n;
+    }
+
+    return result;
+}
+
+#ifndef SSD1306_USE_DMA
+static void ssd1306_i2c_send_commands(ssd1306_t *p, const uint8_t *cmds, size_t len) {
+    ssd1306_i2c_commands(p, cmds, len);
+}
+
+static void ssd1306_i2c_windows(ssd1306_t *p) {
+    int result=PICO_OK;
+
+    for(size_t i=0; i<p->tx_windows; ++i) {
+        const ssd1306_window_t *w=&p->tx_window[i];
+        uint8_t cmds[SSD1306_WINDOW_COMMANDS];
+
+        ssd1306_window_commands(p, w, cmds);
+        if(ssd1306_i2c_commands(p, cmds, sizeof(cmds))!=PICO_OK)
+            result=PICO_ERROR_GENERIC;
+
+        const size_t len=w->x1-w->x0+1;
+        uint8_t *start=p->tx_src+w->page0*SSD1306_WIDTH(p)+w->x0-1;
+
+        // the byte in front of the data is temporarily replaced by the control byte
+        if(len==SSD1306_WIDTH(p)) { // whole pages are contiguous in the buffer
+            uint8_t prev=*start;
+            *start=0x40;
+            if(fancy_write(p, start, len*(w->page1-w->page0+1)+1, "ssd1306_show")!=PICO_OK)
+                result=PICO_ERROR_GENERIC;
+            *start=prev;
+        } else {
+            for(uint32_t page=w->page0; page<=w->page1; ++page, start+=SSD1306_WIDTH(p)) {
+                uint8_t prev=*start;
+                *start=0x40;
+                if(fancy_write(p, start, len+1, "ssd1306_show")!=PICO_OK)
+                    result=PICO_ERROR_GENERIC;
+                *start=prev;
+            }
+        }
+    }
+
+    ssd1306_transport_done(p, result);
+}
+
+const ssd1306_transport_t ssd1306_i2c_transport= {
+    .commands=ssd1306_i2c_send_commands,
+    .windows=ssd1306_i2c_windows,
+    .bus=ssd1306_i2c_bus,
+};
+#endif
+
+#ifdef SSD1306_USE_DMA
+#if SSD1306_DMA_CHUNK<SSD1306_WINDOW_COMMANDS+2
+#error "SSD1306_DMA_CHUNK has to hold the 8 words that set up a window"
+#endif
+
+static ssd1306_t *ssd1306_dma_displays[NUM_DMA_CHANNELS];
+// display whose transfer is running on each i2c bus
+static ssd1306_t *volatile ssd1306_i2c_active[2];
+
+#ifdef SSD1306_USE_SPI
+static void ssd1306_spi_dma_next(ssd1306_t *p);
+#endif
+
+// queues the address window commands followed by the control byte of its data
+static size_t ssd1306_dma_window(ssd1306_t *p, size_t n) {
+    const ssd1306_window_t *w=&p->tx_window[p->tx_win++];
+    uint8_t cmds[SSD1306_WINDOW_COMMANDS];
+
+    ssd1306_window_commands(p, w, cmds);
+
+    // every part starts with a repeated start, only the end of the whole stream has a stop
+    p->dma_tx_buffer[n++]=1u << I2C_IC_DATA_CMD_RESTART_LSB | 0x0000;
+    for(size_t i=0; i<sizeof(cmds); ++i)
+        p->dma_tx_buffer[n++]=cmds[i];
+    p->dma_tx_buffer[n++]=1u << I2C_IC_DATA_CMD_RESTART_LSB | 0x0040;
+
+    p->tx_x0=w->x0;
+    p->tx_x1=w->x1;
+    p->tx_col=w->x0;
+    p->tx_page=w->page0;
+    p->tx_page1=w->page1;
+
+    return n;
+}
+
+// fills the chunk buffer with the next words of the stream, returns the number of words
+static size_t ssd1306_dma_fill(ssd1306_t *p) {
+    size_t n=0;
+
+    while(n<SSD1306_DMA_CHUNK) {
+        if(p->tx_page>p->tx_page1) {
+            if(p->tx_win==p->tx_windows || n+SSD1306_WINDOW_COMMANDS+2>SSD1306_DMA_CHUNK)
+                break;
+            n=ssd1306_dma_window(p, n);
+        }
+
+        const uint8_t *row=p->tx_src+p->tx_page*SSD1306_WIDTH(p);
+        while(n<SSD1306_DMA_CHUNK && p->tx_page<=p->tx_page1) {
+            p->dma_tx_buffer[n++]=row[p->tx_col];
+            if(p->tx_col++==p->tx_x1) {
+                p->tx_col=p->tx_x0;
+                ++p->tx_page;
+                row+=SSD1306_WIDTH(p);
+            }
+        }
+    }
+
+    if(n && p->tx_win==p->tx_windows && p->tx_page>p->tx_page1)
+        p->dma_tx_buffer[n-1]|=1u << I2C_IC_DATA_CMD_STOP_LSB;
+
+    return n;
+}
+
+// queues the next part of the transfer once the dma has read the previous one
+static void ssd1306_dma_irq_handler(void) {
+    for(uint ch=0; ch<NUM_DMA_CHANNELS; ++ch) {
+        ssd1306_t *p=ssd1306_dma_displays[ch];
+        if(p==NULL || !dma_channel_get_irq0_status(ch))
+            continue;
+
+        dma_channel_acknowledge_irq0(ch);
+
+#ifdef SSD1306_USE_SPI
+        if(p->transport==&ssd1306_spi_transport) {
+            ssd1306_spi_dma_next(p);
+            continue;
+        }
+#endif
+
+        // the transfer is completed by the stop of the last byte, see ssd1306_i2c_irq
+        size_t n=ssd1306_dma_fill(p);
+        if(n)
+            dma_channel_transfer_from_buffer_now(ch, p->dma_tx_buffer, n);
+    }
+}
+
+// claims the dma channel of the display and routes its interrupt to ssd1306_dma_irq_handler
+static void ssd1306_dma_claim(ssd1306_t *p) {
+    static bool irq_installed=false;
+
+    dma_channel_claim(p->dma_channel);
+    ssd1306_dma_displays[p->dma_channel]=p;
+    dma_channel_set_irq0_enabled(p->dma_channel, true);
+    if(!irq_installed) {
+        irq_add_shared_handler(DMA_IRQ_0, ssd1306_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(DMA_IRQ_0, true);
+        irq_installed=true;
+    }
+}
+
+static void ssd1306_dma_release(ssd1306_t *p) {
+    dma_channel_set_irq0_enabled(p->dma_channel, false);
+    ssd1306_dma_displays[p->dma_channel]=NULL;
+    dma_channel_unclaim(p->dma_channel);
+}
+
+// finishes the transfer on the stop condition, or cancels it when the display did not acknowledge
+static void ssd1306_i2c_irq(uint index) {
+    ssd1306_t *p=ssd1306_i2c_active[index];
+    if(p==NULL)
+        return;
+
+    i2c_hw_t *hw=i2c_get_hw(p->i2c_i);
+    const uint32_t status=hw->raw_intr_stat;
+    int result=PICO_OK;
+
+    if(status & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS) {
+        // the fifo is flushed on an abort, so stop the dma from feeding the rest of the stream
+        dma_channel_set_irq0_enabled(p->dma_channel, false);
+        dma_channel_abort(p->dma_channel);
+        dma_channel_acknowledge_irq0(p->dma_channel);
+        dma_channel_set_irq0_enabled(p->dma_channel, true);
+        p->tx_win=p->tx_windows;
+        p->tx_page=p->tx_page1+1;
+        (void) hw->clr_tx_abrt;
+        result=PICO_ERROR_GENERIC;
+        ssd1306_stats_error(p, result);
+    } else if(!(status & I2C_IC_RAW_INTR_STAT_STOP_DET_BITS)) {
+        return;
+    }
+
+    (void) hw->clr_stop_det;
+    hw->intr_mask=0;
+    ssd1306_i2c_active[index]=NULL;
+
+    ssd1306_transport_done(p, result);
+}
+
+static void ssd1306_i2c0_irq_handler(void) {
+    ssd1306_i2c_irq(0);
+}
+
+static void ssd1306_i2c1_irq_handler(void) {
+    ssd1306_i2c_irq(1);
+}
+
+static bool ssd1306_i2c_dma_init(ssd1306_t *p) {
+    static bool irq_installed[2]= {false, false};
+    const uint index=i2c_hw_index(p->i2c_i);
+
+    ssd1306_dma_claim(p);
+    if(!irq_installed[index]) {
+        irq_add_shared_handler(I2C0_IRQ+index, index ? ssd1306_i2c1_irq_handler : ssd1306_i2c0_irq_handler,
+                               PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+        irq_set_enabled(I2C0_IRQ+index, true);
+        irq_installed[index]=true;
+    }
+
+    return true;
+}
+
+static void ssd1306_i2c_dma_commands(ssd1306_t *p, const uint8_t *cmds, size_t len) {
+    // the bus may still be busy with the previous frame
+    ssd1306_wait(p);
+    ssd1306_i2c_commands(p, cmds, len);
+}
+
+// streams the queued windows of tx_src to the display, the chunk buffer is refilled from the dma interrupt
+static void ssd1306_i2c_dma_windows(ssd1306_t *p) {
+    const uint index=i2c_hw_index(p->i2c_i);
+    i2c_hw_t *hw=i2c_get_hw(p->i2c_i);
+
+    // no window is loaded yet
+    p->tx_win=0;
+    p->tx_page=1;
+    p->tx_page1=0;
+
+    // set the address of the display that we want to write to
+    hw->enable=0;
+    hw->tar=p->address;
+    hw->enable=1;
+
+    (void) hw->clr_stop_det;
+    (void) hw->clr_tx_abrt;
+    ssd1306_i2c_active[index]=p;
+    hw->intr_mask=I2C_IC_INTR_MASK_M_STOP_DET_BITS | I2C_IC_INTR_MASK_M_TX_ABRT_BITS;
+
+    size_t transfers=ssd1306_dma_fill(p);
+
+    // each transfer writes one 16 bit data_cmd word, the upper byte holds the restart/stop flags
+    dma_channel_config dma_config = dma_channel_get_default_config(p->dma_channel);
+    channel_config_set_transfer_data_size(&dma_config, DMA_SIZE_16);
+    channel_config_set_read_increment(&dma_config, true);
+    channel_config_set_write_increment(&dma_config, false);
+    // configure the i2c channel to cooperate with the dma engine
+    channel_config_set_dreq(&dma_config, i2c_get_dreq(p->i2c_i, true));
+    dma_channel_configure(
+        p->dma_channel,                        // Channel to be configured
+        &dma_config,                           // The configuration we just created
+        &hw->data_cmd,                         // The initial write address
+        p->dma_tx_buffer,                      // The initial read address
+        transfers,                             // Number of transfers; in this case each is 2 byte.
+        true                                   // Start immediately.
+    );
+}
+
+static bool ssd1306_i2c_dma_busy(ssd1306_t *p) {
+    return ssd1306_i2c_active[i2c_hw_index(p->i2c_i)]!=NULL;
+}
+
+const ssd1306_transport_t ssd1306_i2c_dma_transport= {
+    .init=ssd1306_i2c_dma_init,
+    .deinit=ssd1306_dma_release,
+    .commands=ssd1306_i2c_dma_commands,
+    .windows=ssd1306_i2c_dma_windows,
+    .busy=ssd1306_i2c_dma_busy,
+    .bus=ssd1306_i2c_bus,
+};
+#endif
+
+#ifdef SSD1306_USE_SPI
+static inline void ssd1306_spi_select(ssd1306_t *p, bool select) {
+    if(p->cs_pin!=SSD1306_NO_PIN)
+        gpio_put(p->cs_pin, !select);
+}
+
+// sends bytes with the d/c pin low for commands and high for data, returns once they were shifted out
+static void ssd1306_spi_write(ssd1306_t *p, bool data, const uint8_t *src, size_t len) {
+    gpio_put(p->dc_pin, data);
+    spi_write_blocking(p->spi, src, len);
+}
+
+// sends the commands of the next window and leaves the d/c pin high for its data
+static void ssd1306_spi_window(ssd1306_t *p, const ssd1306_window_t *w) {
+    uint8_t cmds[SSD1306_WINDOW_COMMANDS];
+
+    ssd1306_window_commands(p, w, cmds);
+    ssd1306_spi_write(p, false, cmds, sizeof(cmds));
+    gpio_put(p->dc_pin, 1);
+}
+
+static bool ssd1306_spi_init(ssd1306_t *p) {
+    gpio_init(p->dc_pin);
+    gpio_set_dir(p->dc_pin, GPIO_OUT);
+    if(p->cs_pin!=SSD1306_NO_PIN) {
+        gpio_init(p->cs_pin);
+        gpio_set_dir(p->cs_pin, GPIO_OUT);
+        gpio_put(p->cs_pin, 1);
+    }
+
+#ifdef SSD1306_USE_DMA
+    ssd1306_dma_claim(p);
+#endif
+    return true;
+}
+
+static void ssd1306_spi_commands(ssd1306_t *p, const uint8_t *cmds, size_t len) {
+    ssd1306_wait(p);
+    ssd1306_spi_select(p, true);
+    ssd1306_spi_write(p, false, cmds, len);
+    ssd1306_spi_select(p, false);
+}
+
+static const void *ssd1306_spi_bus(ssd1306_t *p) {
+    return p->spi;
+}
+
+#ifdef SSD1306_USE_DMA
+// display whose transfer is running on each spi bus
+static ssd1306_t *volatile ssd1306_spi_active[2];
+
+// starts the dma for the next part of the transfer, finishes the transfer once all windows were sent
+static void ssd1306_spi_dma_next(ssd1306_t *p) {
+    if(p->tx_page>p->tx_page1) {
+        // the d/c pin may only change once the last data byte was shifted out
+        while(spi_is_busy(p->spi))
+            tight_loop_contents();
+
+        if(p->tx_win==p->tx_windows) {
+            ssd1306_spi_select(p, false);
+            ssd1306_spi_active[spi_get_index(p->spi)]=NULL;
+            ssd1306_transport_done(p, PICO_OK);
+            return;
+        }
+
+        const ssd1306_window_t *w=&p->tx_window[p->tx_win++];
+        ssd1306_spi_window(p, w);
+        p->tx_x0=w->x0;
+        p->tx_x1=w->x1;
+        p->tx_page=w->page0;
+        p->tx_page1=w->page1;
+    }
+
+    const uint8_t *src=p->tx_src+p->tx_page*SSD1306_WIDTH(p)+p->tx_x0;
+    size_t len=p->tx_x1-p->tx_x0+1;
+
+    if(len==SSD1306_WIDTH(p)) { // whole pages are contiguous in the buffer
+        len*=p->tx_page1-p->tx_page+1;
+        p->tx_page=p->tx_page1+1;
+    } else {
+        ++p->tx_page;
+    }
+
+    dma_channel_transfer_from_buffer_now(p->dma_channel, src, len);
+}
+
+// streams the queued windows, the commands of each window are sent from the dma interrupt
+static void ssd1306_spi_windows(ssd1306_t *p) {
+    dma_channel_config dma_config = dma_channel_get_default_config(p->dma_channel);
+    channel_config_set_transfer_data_size(&dma_config, DMA_SIZE_8);
+    channel_config_set_read_increment(&dma_config, true);
+    channel_config_set_write_increment(&dma_config, false);
+    channel_config_set_dreq(&dma_config, spi_get_dreq(p->spi, true));
+    dma_channel_configure(p->dma_channel, &dma_config, &spi_get_hw(p->spi)->dr, p->tx_src, 0, false);
+
+    // no window is loaded yet
+    p->tx_win=0;
+    p->tx_page=1;
+    p->tx_page1=0;
+
+    ssd1306_spi_active[spi_get_index(p->spi)]=p;
+    ssd1306_spi_select(p, true);
+    ssd1306_spi_dma_next(p);
+}
+
+static bool ssd1306_spi_busy(ssd1306_t *p) {
+    return ssd1306_spi_active[spi_get_index(p->spi)]!=NULL;
 }
 #else
-inline static void ssd1306_write(ssd1306_t *p, uint8_t val) {
-    uint8_t d[2]= {0x00, val};
-    fancy_write(p->i2c_i, p->address, d, 2, "ssd1306_write");
+static void ssd1306_spi_windows(ssd1306_t *p) {
+    ssd1306_spi_select(p, true);
+
+    for(size_t i=0; i<p->tx_windows; ++i) {
+        const ssd1306_window_t *w=&p->tx_window[i];
+        const size_t len=w->x1-w->x0+1;
+        const uint8_t *start=p->tx_src+w->page0*SSD1306_WIDTH(p)+w->x0;
+
+        ssd1306_spi_window(p, w);
+        if(len==SSD1306_WIDTH(p)) { // whole pages are contiguous in the buffer
+            spi_write_blocking(p->spi, start, len*(w->page1-w->page0+1));
+        } else {
+            for(uint32_t page=w->page0; page<=w->page1; ++page, start+=SSD1306_WIDTH(p))
+                spi_write_blocking(p->spi, start, len);
+        }
+    }
+
+    ssd1306_spi_select(p, false);
+    ssd1306_transport_done(p, PICO_OK);
 }
 #endif
 
+const ssd1306_transport_t ssd1306_spi_transport= {
+    .init=ssd1306_spi_init,
+#ifdef SSD1306_USE_DMA
+    .deinit=ssd1306_dma_release,
+    .busy=ssd1306_spi_busy,
+#endif
+    .commands=ssd1306_spi_commands,
+    .windows=ssd1306_spi_windows,
+    .bus=ssd1306_spi_bus,
+};
+#endif
+
+// number of argument bytes following a command
+static uint8_t ssd1306_command_args(uint8_t cmd) {
+    switch(cmd) {
+    case SET_HORIZ_SCROLL:
+    case SET_HORIZ_SCROLL+1:
+        return 6;
+    case SET_VERT_HORIZ_SCROLL:
+    case SET_VERT_HORIZ_SCROLL+1:
+        return 5;
+    case SET_COL_ADDR:
+    case SET_PAGE_ADDR:
+    case SET_VERT_SCROLL_AREA:
+        return 2;
+    case SET_MEM_ADDR:
+    case SET_CONTRAST:
+    case SET_CHARGE_PUMP:
+    case SET_MUX_RATIO:
+    case SET_DISP_OFFSET:
+    case SET_COM_PIN_CFG:
+    case SET_DISP_CLK_DIV:
+    case SET_PRECHARGE:
+    case SET_VCOM_DESEL:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+static void ssd1306_memory_command(ssd1306_memory_t *m, uint8_t b) {
+    ++m->command_bytes;
+
+    if(m->args==0) {
+        m->command=b;
+        m->args=ssd1306_command_args(b);
+        return;
+    }
+
+    const uint8_t i=ssd1306_command_args(m->command)-m->args;
+    if(i<sizeof(m->arg))
+        m->arg[i]=b;
+    if(--m->args)
+        return;
+
+    if(m->command==SET_COL_ADDR) {
+        m->col0=m->col=m->arg[0]&127;
+        m->col1=m->arg[1]&127;
+    } else if(m->command==SET_PAGE_ADDR) {
+        m->page0=m->page=m->arg[0]&7;
+        m->page1=m->arg[1]&7;
+    }
+}
+
+// stores the byte and advances like the horizontal addressing mode
+static inline void ssd1306_memory_data(ssd1306_memory_t *m, uint8_t b) {
+    m->ram[m->page][m->col]=b;
+
+    if(m->col!=m->col1) {
+        m->col=(m->col+1)&127;
+    } else {
+        m->col=m->col0;
+        m->page=m->page==m->page1 ? m->page0 : (m->page+1)&7;
+    }
+}
+
+static bool ssd1306_memory_init(ssd1306_t *p) {
+    ssd1306_memory_t *m=p->transport_ctx;
+
+    memset(m, 0, sizeof(*m));
+    m->col1=127;
+    m->page1=7;
+    return true;
+}
+
+static void ssd1306_memory_commands(ssd1306_t *p, const uint8_t *cmds, size_t len) {
+    ssd1306_memory_t *m=p->transport_ctx;
+
+    ++m->transfers;
+    for(size_t i=0; i<len; ++i)
+        ssd1306_memory_command(m, cmds[i]);
+}
+
+static void ssd1306_memory_windows(ssd1306_t *p) {
+    ssd1306_memory_t *m=p->transport_ctx;
+
+    for(size_t i=0; i<p->tx_windows; ++i) {
+        const ssd1306_window_t *w=&p->tx_window[i];
+        uint8_t cmds[SSD1306_WINDOW_COMMANDS];
+
+        ssd1306_window_commands(p, w, cmds);
+        ssd1306_memory_commands(p, cmds, sizeof(cmds));
+
+        ++m->transfers;
+        for(uint32_t page=w->page0; page<=w->page1; ++page) {
+            const uint8_t *row=p->tx_src+page*SSD1306_WIDTH(p);
+            for(uint32_t x=w->x0; x<=w->x1; ++x)
+                ssd1306_memory_data(m, row[x]);
+        }
+        m->data_bytes+=(w->x1-w->x0+1)*(w->page1-w->page0+1);
+    }
+
+    ssd1306_transport_done(p, PICO_OK);
+}
+
+static const void *ssd1306_memory_bus(ssd1306_t *p) {
+    return p->transport_ctx;
+}
+
+const ssd1306_transport_t ssd1306_memory_transport= {
+    .init=ssd1306_memory_init,
+    .commands=ssd1306_memory_commands,
+    .windows=ssd1306_memory_windows,
+    .bus=ssd1306_memory_bus,
+};
+
+void ssd1306_write_commands(ssd1306_t *p, const uint8_t *cmds, size_t len) {
+    ssd1306_stats_commands(p, len);
+    p->transport->commands(p, cmds, len);
+}
+
+static inline void ssd1306_mark_dirty(ssd1306_t *p, uint32_t x0, uint32_t x1, uint32_t page0, uint32_t page1) {
+    if(x0<p->dirty_x0) p->dirty_x0=x0;
+    if(x1>p->dirty_x1) p->dirty_x1=x1;
+    if(page0<p->dirty_p0) p->dirty_p0=page0;
+    if(page1>p->dirty_p1) p->dirty_p1=page1;
+}
+
+static inline void ssd1306_mark_clean(ssd1306_t *p) {
+    p->dirty_x0=SSD1306_WIDTH(p);
+    p->dirty_x1=0;
+    p->dirty_p0=SSD1306_PAGES(p);
+    p->dirty_p1=0;
+}
+
 #ifdef SSD1306_USE_DMA
 bool ssd1306_init(ssd1306_t *p) {
     uint8_t startup_commands[]= {
@@ -77,7 +771,7 @@ bool ssd1306_init(ssd1306_t *p) {
         SET_DISP_CLK_DIV,
         0x80,
         SET_MUX_RATIO,
-        p->height - 1,
+        SSD1306_HEIGHT(p) - 1,
         SET_DISP_OFFSET,
         0x00,
         SET_DISP_START_LINE,
@@ -86,7 +780,7 @@ bool ssd1306_init(ssd1306_t *p) {
         SET_SEG_REMAP | 0x01,
         SET_COM_OUT_DIR | 0x08,
         SET_COM_PIN_CFG,
-        p->width > 2 * p->height ? 0x02 : 0x12,
+        SSD1306_WIDTH(p) > 2 * SSD1306_HEIGHT(p) ? 0x02 : 0x12,
         SET_CONTRAST,
         0xff,
         SET_PRECHARGE,
@@ -99,28 +793,66 @@ bool ssd1306_init(ssd1306_t *p) {
         SET_MEM_ADDR,
         0x00,
     };
-    dma_channel_claim(p->dma_channel);
-    for(size_t i=0; i<sizeof(startup_commands); ++i) {
-        ssd1306_write(p, startup_commands[i]);
-    }
+
+#ifdef SSD1306_FIXED_WIDTH
+    if(p->width!=SSD1306_FIXED_WIDTH || p->height!=SSD1306_FIXED_HEIGHT)
+        return false;
+#endif
+
+    p->scrolling=false;
+#ifdef SSD1306_USE_STATS
+    memset(&p->stats, 0, sizeof(p->stats));
+#endif
+    if(p->transport->init!=NULL && !p->transport->init(p))
+        return false;
+
+    ssd1306_write_commands(p, startup_commands, sizeof(startup_commands));
+
+    return true;
 }
 #else
-bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address, i2c_inst_t *i2c_instance) {
+bool ssd1306_init_transport(ssd1306_t *p, uint16_t width, uint16_t height, const ssd1306_transport_t *transport,
+                            void *ctx) {
+#ifdef SSD1306_FIXED_WIDTH
+    if(width!=SSD1306_FIXED_WIDTH || height!=SSD1306_FIXED_HEIGHT)
+        return false;
+#endif
+
     p->width=width;
     p->height=height;
     p->pages=height/8;
-    p->address=address;
-
-    p->i2c_i=i2c_instance;
 
+    p->transport=transport;
+    p->transport_ctx=ctx;
+    p->tx_callback=NULL;
+    p->scrolling=false;
+#ifdef SSD1306_USE_STATS
+    memset(&p->stats, 0, sizeof(p->stats));
+#endif
 
-    p->bufsize=(p->pages)*(p->width);
-    if((p->buffer=malloc(p->bufsize+1))==NULL) {
+    p->bufsize=(SSD1306_PAGES(p))*(SSD1306_WIDTH(p));
+    // the buffer is preceded by a word holding the i2c control byte, so the buffer itself
+    // stays word aligned for ssd1306_show
+    if((p->buffer=malloc(p->bufsize+4))==NULL) {
         p->bufsize=0;
         return false;
     }
 
-    ++(p->buffer);
+    p->buffer+=4;
+    p->shadow=NULL;
+    p->flush_bytes=0;
+
+    // the display ram content is unknown, so the first show has to send everything
+    p->dirty_x0=0;
+    p->dirty_x1=SSD1306_WIDTH(p)-1;
+    p->dirty_p0=0;
+    p->dirty_p1=SSD1306_PAGES(p)-1;
+
+    if(transport->init!=NULL && !transport->init(p)) {
+        free(p->buffer-4);
+        p->bufsize=0;
+        return false;
+    }
 
     // from https://github.com/makerportal/rpi-pico-ssd1306
     uint8_t cmds[]= {
@@ -156,117 +888,844 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
         0x00,  // horizontal
     };
 
-    for(size_t i=0; i<sizeof(cmds); ++i)
-        ssd1306_write(p, cmds[i]);
+    ssd1306_write_commands(p, cmds, sizeof(cmds));
+
+    return true;
+}
+
+bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address, i2c_inst_t *i2c_instance) {
+    p->address=address;
+    p->i2c_i=i2c_instance;
+
+    return ssd1306_init_transport(p, width, height, &ssd1306_i2c_transport, NULL);
+}
+
+#ifdef SSD1306_USE_SPI
+bool ssd1306_init_spi(ssd1306_t *p, uint16_t width, uint16_t height, spi_inst_t *spi_instance, uint8_t dc_pin,
+                      uint8_t cs_pin) {
+    p->spi=spi_instance;
+    p->dc_pin=dc_pin;
+    p->cs_pin=cs_pin;
+
+    return ssd1306_init_transport(p, width, height, &ssd1306_spi_transport, NULL);
+}
+#endif
+#endif
+
+void ssd1306_deinit(ssd1306_t *p) {
+    ssd1306_wait(p);
+    if(p->transport->deinit!=NULL)
+        p->transport->deinit(p);
+#ifndef SSD1306_USE_DMA
+    free(p->buffer-4);
+#endif
+}
+
+inline void ssd1306_poweroff(ssd1306_t *p) {
+    uint8_t cmd=SET_DISP|0x00;
+    ssd1306_write_commands(p, &cmd, 1);
+}
+
+inline void ssd1306_poweron(ssd1306_t *p) {
+    uint8_t cmd=SET_DISP|0x01;
+    ssd1306_write_commands(p, &cmd, 1);
+}
+
+inline void ssd1306_contrast(ssd1306_t *p, uint8_t val) {
+    uint8_t cmds[]= {SET_CONTRAST, val};
+    ssd1306_write_commands(p, cmds, sizeof(cmds));
+}
+
+inline void ssd1306_invert(ssd1306_t *p, uint8_t inv) {
+    uint8_t cmd=SET_NORM_INV | (inv & 1);
+    ssd1306_write_commands(p, &cmd, 1);
+}
+
+void ssd1306_scroll_stop(ssd1306_t *p) {
+    uint8_t cmd=SET_SCROLL;
+    ssd1306_write_commands(p, &cmd, 1);
+
+    if(!p->scrolling)
+        return;
+
+    // the display ram of the scrolled pages no longer matches the buffer
+    p->scrolling=false;
+    p->shadow_valid=false;
+    ssd1306_mark_dirty(p, 0, SSD1306_WIDTH(p)-1, p->scroll_page0, p->scroll_page1);
+}
+
+// scrolls have to be stopped before the display ram is written
+static inline void ssd1306_scroll_end(ssd1306_t *p) {
+    if(p->scrolling)
+        ssd1306_scroll_stop(p);
+}
+
+// orders the page range of a scroll and limits it to the pages of the display
+static void ssd1306_scroll_pages(ssd1306_t *p, uint8_t *page0, uint8_t *page1) {
+    const uint8_t last=SSD1306_PAGES(p)-1;
+
+    if(*page0>*page1) {
+        const uint8_t t=*page0;
+        *page0=*page1;
+        *page1=t;
+    }
+    if(*page0>last) *page0=last;
+    if(*page1>last) *page1=last;
+}
+
+static void ssd1306_scroll_start(ssd1306_t *p, const uint8_t *setup, size_t len, uint8_t page0, uint8_t page1) {
+    // parameters may only change while no scroll runs
+    ssd1306_scroll_stop(p);
+    ssd1306_write_commands(p, setup, len);
+    p->scrolling=true;
+    p->scroll_page0=page0;
+    p->scroll_page1=page1;
+}
+
+void ssd1306_scroll_horizontal(ssd1306_t *p, ssd1306_scroll_dir_t dir, uint8_t page0, uint8_t page1,
+                               ssd1306_scroll_speed_t speed) {
+    ssd1306_scroll_pages(p, &page0, &page1);
+
+    const uint8_t cmds[]= {
+        SET_HORIZ_SCROLL | dir,
+        0x00,
+        page0,
+        speed,
+        page1,
+        0x00,
+        0xff,
+        SET_SCROLL | 0x01,
+    };
+
+    ssd1306_scroll_start(p, cmds, sizeof(cmds), page0, page1);
+}
+
+void ssd1306_scroll_diagonal(ssd1306_t *p, ssd1306_scroll_dir_t dir, uint8_t page0, uint8_t page1,
+                             ssd1306_scroll_speed_t speed, uint8_t offset) {
+    ssd1306_scroll_pages(p, &page0, &page1);
+
+    const uint8_t cmds[]= {
+        SET_VERT_HORIZ_SCROLL | dir,
+        0x00,
+        page0,
+        speed,
+        page1,
+        offset & 0x3f,
+        SET_SCROLL | 0x01,
+    };
+
+    ssd1306_scroll_start(p, cmds, sizeof(cmds), page0, page1);
+}
+
+void ssd1306_scroll_area(ssd1306_t *p, uint8_t fixed_rows, uint8_t rows) {
+    const uint8_t cmds[]= {SET_VERT_SCROLL_AREA, fixed_rows & 0x3f, rows & 0x7f};
+    ssd1306_write_commands(p, cmds, sizeof(cmds));
+}
+
+inline void ssd1306_clear(ssd1306_t *p) {
+    memset((uint8_t *) p->buffer, 0, p->bufsize);
+    ssd1306_mark_dirty(p, 0, SSD1306_WIDTH(p)-1, 0, SSD1306_PAGES(p)-1);
+}
+
+void ssd1306_clear_pixel(ssd1306_t *p, uint32_t x, uint32_t y) {
+    if(x>=SSD1306_WIDTH(p) || y>=SSD1306_HEIGHT(p)) return;
+
+    p->buffer[x+SSD1306_WIDTH(p)*(y>>3)]&=~(0x1<<(y&0x07));
+    ssd1306_mark_dirty(p, x, x, y>>3, y>>3);
+}
+
+void ssd1306_draw_pixel(ssd1306_t *p, uint32_t x, uint32_t y) {
+    if(x>=SSD1306_WIDTH(p) || y>=SSD1306_HEIGHT(p)) return;
+
+    p->buffer[x+SSD1306_WIDTH(p)*(y>>3)]|=0x1<<(y&0x07); // y>>3==y/8 && y&0x7==y%8
+    ssd1306_mark_dirty(p, x, x, y>>3, y>>3);
+}
+
+// sets or clears the bits of mask in n bytes of a row
+static inline void ssd1306_mask_span(uint8_t *row, uint8_t mask, uint32_t n, bool set) {
+    if(mask==0xff) {
+        memset(row, set?0xff:0x00, n);
+    } else if(set) {
+        for(uint32_t i=0; i<n; ++i)
+            row[i]|=mask;
+    } else {
+        for(uint32_t i=0; i<n; ++i)
+            row[i]&=~mask;
+    }
+}
+
+// sets or clears all pixels of the rectangle a page byte at a time
+static void ssd1306_fill_rect(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool set) {
+    if(x>=SSD1306_WIDTH(p) || y>=SSD1306_HEIGHT(p) || width==0 || height==0) return;
+
+    if(width>SSD1306_WIDTH(p)-x) width=SSD1306_WIDTH(p)-x;
+    if(height>SSD1306_HEIGHT(p)-y) height=SSD1306_HEIGHT(p)-y;
+
+    const uint32_t last=y+height-1;
+    const uint32_t page0=y>>3, page1=last>>3;
+    const uint8_t top=0xff<<(y&7), bottom=0xff>>(7-(last&7));
+    uint8_t *row=(uint8_t *) p->buffer+page0*SSD1306_WIDTH(p)+x;
+
+    ssd1306_mark_dirty(p, x, x+width-1, page0, page1);
+
+    if(page0==page1) {
+        ssd1306_mask_span(row, top&bottom, width, set);
+        return;
+    }
+
+    ssd1306_mask_span(row, top, width, set);
+    row+=SSD1306_WIDTH(p);
+
+    // the whole pages in between are contiguous if the rows span the display
+    const uint32_t pages=page1-page0-1;
+    if(width==SSD1306_WIDTH(p)) {
+        memset(row, set?0xff:0x00, pages*width);
+        row+=pages*SSD1306_WIDTH(p);
+    } else {
+        for(uint32_t page=0; page<pages; ++page, row+=SSD1306_WIDTH(p))
+            memset(row, set?0xff:0x00, width);
+    }
+
+    ssd1306_mask_span(row, bottom, width, set);
+}
+
+// sets a pixel of a line, box holds the first and the last pixel set, box[0] is -1 before the first
+static inline void ssd1306_line_pixel(ssd1306_t *p, int32_t x, int32_t y, int32_t box[4]) {
+    p->buffer[x+SSD1306_WIDTH(p)*(y>>3)]|=0x1<<(y&0x07);
+    if(box[0]<0) {
+        box[0]=x;
+        box[1]=y;
+    }
+    box[2]=x;
+    box[3]=y;
+}
+
+void ssd1306_draw_line(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
+    if(x1>x2) {
+        swap(&x1, &x2);
+        swap(&y1, &y2);
+    }
+
+    if(y1==y2) { // horizontal span
+        if(y1<0 || x2<0) return;
+        if(x1<0) x1=0;
+        ssd1306_fill_rect(p, x1, y1, (uint32_t) (x2-x1)+1, 1, true);
+        return;
+    }
+
+    if(x1==x2) { // vertical span
+        if(y1>y2)
+            swap(&y1, &y2);
+        if(x1<0 || y2<0) return;
+        if(y1<0) y1=0;
+        ssd1306_fill_rect(p, x1, y1, 1, (uint32_t) (y2-y1)+1, true);
+        return;
+    }
+
+    // bresenham along the major axis, starting at the first step on the display.
+    // after k steps the minor axis moved m=(2*minor*k+major-1)/(2*major) times,
+    // so position and error term of the first visible step can be computed directly
+    const int64_t dx=(int64_t) x2-x1, dy=y2>y1?(int64_t) y2-y1:(int64_t) y1-y2;
+    const int32_t sy=y2>y1?1:-1;
+    const bool steep=dy>dx;
+    const int64_t major=steep?dy:dx, minor=steep?dx:dy;
+    const int32_t major_start=steep?y1:x1, minor_start=steep?x1:y1;
+    const int32_t major_step=steep?sy:1, minor_step=steep?1:sy;
+    const int32_t major_size=steep?SSD1306_HEIGHT(p):SSD1306_WIDTH(p), minor_size=steep?SSD1306_WIDTH(p):SSD1306_HEIGHT(p);
+
+    // clip the major axis
+    int64_t k0=major_step>0?-(int64_t) major_start:(int64_t) major_start-(major_size-1);
+    int64_t k1=major_step>0?(int64_t) major_size-1-major_start:major_start;
+    if(k0<0) k0=0;
+    if(k1>major) k1=major;
+    if(k0>k1) return;
+
+    int64_t m=(2*minor*k0+major-1)/(2*major);
+    int64_t err=2*minor*(k0+1)-major-2*major*m;
+    int32_t a=major_start+major_step*(int32_t) k0;
+    int32_t b=minor_start+minor_step*(int32_t) m;
+    int32_t box[4]= {-1, 0, 0, 0};
+
+    // the clipped run has at most one step per display row or column, so the per pixel loop
+    // stays in 32 bit unless the error term itself does not fit, i.e. for lines of 2^30 pixels
+    int32_t n=(int32_t) (k1-k0)+1;
+    if(major<=INT32_MAX/2) {
+        const int32_t d_major=2*(int32_t) major, d_minor=2*(int32_t) minor;
+        int32_t e=(int32_t) err;
+
+        for(; n>0; --n, a+=major_step) {
+            if(b<0 || b>=minor_size) {
+                if(box[0]>=0) // left the display for good
+                    break;
+            } else
+                ssd1306_line_pixel(p, steep?b:a, steep?a:b, box);
+
+            if(e>0) {
+                b+=minor_step;
+                e-=d_major;
+            }
+            e+=d_minor;
+        }
+    } else {
+        for(; n>0; --n, a+=major_step) {
+            if(b<0 || b>=minor_size) {
+                if(box[0]>=0)
+                    break;
+            } else
+                ssd1306_line_pixel(p, steep?b:a, steep?a:b, box);
+
+            if(err>0) {
+                b+=minor_step;
+                err-=2*major;
+            }
+            err+=2*minor;
+        }
+    }
+
+    if(box[0]>=0)
+        ssd1306_mark_dirty(p, box[0]<box[2]?box[0]:box[2], box[0]<box[2]?box[2]:box[0],
+                           (box[1]<box[3]?box[1]:box[3])>>3, (box[1]<box[3]?box[3]:box[1])>>3);
+}
+
+void ssd1306_clear_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    ssd1306_fill_rect(p, x, y, width, height, false);
+}
+
+void ssd1306_draw_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    ssd1306_fill_rect(p, x, y, width, height, true);
+}
+
+void ssd1306_draw_empty_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    ssd1306_fill_rect(p, x, y, width+1, 1, true);
+    ssd1306_fill_rect(p, x, y+height, width+1, 1, true);
+    ssd1306_fill_rect(p, x, y, 1, height+1, true);
+    ssd1306_fill_rect(p, x+width, y, 1, height+1, true);
+}
+
+// bit expansion of a nibble for scale 2 and 3, e.g. 0b0101 -> 0b00110011
+static const uint8_t ssd1306_expand2[16]= {
+    0x00, 0x03, 0x0c, 0x0f, 0x30, 0x33, 0x3c, 0x3f,
+    0xc0, 0xc3, 0xcc, 0xcf, 0xf0, 0xf3, 0xfc, 0xff,
+};
+
+static const uint16_t ssd1306_expand3[16]= {
+    0x000, 0x007, 0x038, 0x03f, 0x1c0, 0x1c7, 0x1f8, 0x1ff,
+    0xe00, 0xe07, 0xe38, 0xe3f, 0xfc0, 0xfc7, 0xff8, 0xfff,
+};
+
+// ors a column of up to 32 pixels into the buffer, bit 0 lands on row y
+static inline void ssd1306_or_column(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t bits) {
+    uint32_t page=y>>3;
+    uint64_t v=(uint64_t) bits<<(y&7);
+    uint8_t *col=(uint8_t *) p->buffer+page*SSD1306_WIDTH(p)+x;
+
+    for(; v && page<SSD1306_PAGES(p); ++page, v>>=8, col+=SSD1306_WIDTH(p))
+        *col|=(uint8_t) v;
+}
+
+// draws width glyph columns of parts_per_line bytes each, the common part of both font formats
+static void ssd1306_draw_columns(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *glyph,
+                                 uint32_t width, uint32_t parts_per_line) {
+    if(x>=SSD1306_WIDTH(p) || y>=SSD1306_HEIGHT(p) || scale==0 || width==0)
+        return;
+
+    for(uint32_t w=0; w<width; ++w) {
+        const uint32_t col=x+w*scale;
+        if(col>=SSD1306_WIDTH(p))
+            break;
+
+        for(uint32_t lp=0; lp<parts_per_line; ++lp) {
+            const uint8_t line=*(glyph++);
+            const uint32_t row=y+(lp<<3)*scale;
+            if(!line || row>=SSD1306_HEIGHT(p))
+                continue;
+
+            switch(scale) {
+            case 1:
+                ssd1306_or_column(p, col, row, line);
+                break;
+            case 2: {
+                const uint32_t bits=ssd1306_expand2[line&15]|ssd1306_expand2[line>>4]<<8;
+                ssd1306_or_column(p, col, row, bits);
+                if(col+1<SSD1306_WIDTH(p))
+                    ssd1306_or_column(p, col+1, row, bits);
+                break;
+            }
+            case 3: {
+                const uint32_t bits=ssd1306_expand3[line&15]|(uint32_t) ssd1306_expand3[line>>4]<<12;
+                for(uint32_t i=0; i<3 && col+i<SSD1306_WIDTH(p); ++i)
+                    ssd1306_or_column(p, col+i, row, bits);
+                break;
+            }
+            default: // fill each run of set bits as one block
+                for(uint32_t j=0; j<8;) {
+                    if(!(line>>j&1)) {
+                        ++j;
+                        continue;
+                    }
+                    uint32_t run=j;
+                    while(run<8 && (line>>run&1))
+                        ++run;
+                    ssd1306_fill_rect(p, col, row+j*scale, scale, (run-j)*scale, true);
+                    j=run;
+                }
+                break;
+            }
+        }
+    }
+
+    const uint32_t x_end=x+width*scale-1, y_end=y+(parts_per_line<<3)*scale-1;
+    ssd1306_mark_dirty(p, x, x_end<SSD1306_WIDTH(p)?x_end:SSD1306_WIDTH(p)-1u, y>>3, y_end<SSD1306_HEIGHT(p)?y_end>>3:SSD1306_PAGES(p)-1u);
+}
+
+void ssd1306_draw_char_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *font, char c) {
+    if(c<font[3]||c>font[4])
+        return;
+
+    uint32_t parts_per_line=(font[0]>>3)+((font[0]&7)>0);
+    const uint8_t *glyph=font+(c-font[3])*font[1]*parts_per_line+5;
+
+    ssd1306_draw_columns(p, x, y, scale, glyph, font[1], parts_per_line);
+}
+
+void ssd1306_draw_string_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *font, const char *s) {
+    for(int32_t x_n=x; *s; x_n+=(font[1]+font[2])*scale) {
+        ssd1306_draw_char_with_font(p, x_n, y, scale, font, *(s++));
+    }
+}
+
+// index of the glyph of code point c, -1 if the font has none
+static inline int32_t ssd1306_font_glyph(const ssd1306_font_t *font, uint32_t c) {
+    if(c>=font->first && c<=font->last)
+        return c-font->first;
 
-    return true;
+    uint32_t lo=0, hi=font->sparse;
+    while(lo<hi) {
+        const uint32_t mid=(lo+hi)>>1;
+        const uint32_t cp=font->codepoints[mid];
+
+        if(cp==c)
+            return (font->first<=font->last ? font->last-font->first+1 : 0)+mid;
+        if(cp<c)
+            lo=mid+1;
+        else
+            hi=mid;
+    }
+
+    return -1;
 }
-#endif
 
-#ifndef SSD1306_USE_DMA
-inline void ssd1306_deinit(ssd1306_t *p) {
-    free(p->buffer-1);
+// decodes the utf-8 sequence at *s and moves *s behind it, malformed sequences give U+FFFD
+static uint32_t ssd1306_utf8_next(const char **s) {
+    const uint8_t *u=(const uint8_t *) *s;
+    uint32_t c=u[0], len;
+
+    if(c<0x80) {
+        *s+=1;
+        return c;
+    } else if(c>=0xc2 && c<0xe0) {
+        len=2;
+        c&=0x1f;
+    } else if(c>=0xe0 && c<0xf0) {
+        len=3;
+        c&=0x0f;
+    } else if(c>=0xf0 && c<0xf5) {
+        len=4;
+        c&=0x07;
+    } else {
+        *s+=1;
+        return 0xfffd;
+    }
+
+    for(uint32_t i=1; i<len; ++i) {
+        // also stops at the terminating zero of a truncated sequence
+        if((u[i]&0xc0)!=0x80) {
+            *s+=i;
+            return 0xfffd;
+        }
+        c=c<<6 | (u[i]&0x3f);
+    }
+
+    *s+=len;
+
+    // overlong encodings, surrogates and values beyond unicode
+    if((len==3 && c<0x800) || (len==4 && (c<0x10000 || c>0x10ffff)) || (c>=0xd800 && c<=0xdfff))
+        return 0xfffd;
+    return c;
 }
-#endif
 
-inline void ssd1306_poweroff(ssd1306_t *p) {
-    ssd1306_write(p, SET_DISP|0x00);
+// spacing correction between the glyphs left and right
+static int32_t ssd1306_font_kerning(const ssd1306_font_t *font, int32_t left, int32_t right) {
+    if(font->kernings==0 || left<0 || right<0)
+        return 0;
+
+    // pairs are sorted by left and then by right glyph
+    const uint32_t key=(uint32_t) left<<16 | (uint32_t) right;
+    uint32_t lo=0, hi=font->kernings;
+    while(lo<hi) {
+        const uint32_t mid=(lo+hi)>>1;
+        const ssd1306_kerning_t *k=&font->kerning[mid];
+        const uint32_t k_key=(uint32_t) k->left<<16 | k->right;
+
+        if(k_key==key)
+            return k->adjust;
+        if(k_key<key)
+            lo=mid+1;
+        else
+            hi=mid;
+    }
+
+    return 0;
 }
 
-inline void ssd1306_poweron(ssd1306_t *p) {
-    ssd1306_write(p, SET_DISP|0x01);
+uint32_t ssd1306_draw_glyph(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const ssd1306_font_t *font, uint32_t c) {
+    const int32_t i=ssd1306_font_glyph(font, c);
+    if(i<0)
+        return 0;
+
+    const ssd1306_glyph_t *g=&font->glyphs[i];
+    ssd1306_draw_columns(p, x, y, scale, font->bitmap+g->offset, g->width, (font->height+7)>>3);
+    return g->advance*scale;
 }
 
-inline void ssd1306_contrast(ssd1306_t *p, uint8_t val) {
-    ssd1306_write(p, SET_CONTRAST);
-    ssd1306_write(p, val);
+void ssd1306_draw_text(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const ssd1306_font_t *font, const char *s) {
+    const uint32_t parts_per_line=(font->height+7)>>3;
+    int32_t x_n=x, prev=-1;
+
+    while(*s && x_n<(int32_t) SSD1306_WIDTH(p)) {
+        const int32_t i=ssd1306_font_glyph(font, ssd1306_utf8_next(&s));
+        if(i<0)
+            continue;
+
+        x_n+=ssd1306_font_kerning(font, prev, i)*(int32_t) scale;
+        prev=i;
+
+        const ssd1306_glyph_t *g=&font->glyphs[i];
+        if(x_n>=0)
+            ssd1306_draw_columns(p, x_n, y, scale, font->bitmap+g->offset, g->width, parts_per_line);
+        x_n+=g->advance*scale;
+    }
 }
 
-inline void ssd1306_invert(ssd1306_t *p, uint8_t inv) {
-    ssd1306_write(p, SET_NORM_INV | (inv & 1));
+uint32_t ssd1306_text_width(const ssd1306_font_t *font, uint32_t scale, const char *s) {
+    int32_t width=0, prev=-1;
+
+    while(*s) {
+        const int32_t i=ssd1306_font_glyph(font, ssd1306_utf8_next(&s));
+        if(i<0)
+            continue;
+
+        width+=ssd1306_font_kerning(font, prev, i)+font->glyphs[i].advance;
+        prev=i;
+    }
+
+    return width>0 ? width*scale : 0;
 }
 
-inline void ssd1306_clear(ssd1306_t *p) {
-    memset(p->buffer, 0, p->bufsize);
+// first page of the visible line
+static inline uint32_t ssd1306_console_page(ssd1306_console_t *c, uint32_t row) {
+    return (c->top+row*c->line_pages)%SSD1306_PAGES(c->display);
 }
 
-void ssd1306_clear_pixel(ssd1306_t *p, uint32_t x, uint32_t y) {
-    if(x>=p->width || y>=p->height) return;
+bool ssd1306_console_init(ssd1306_console_t *c, ssd1306_t *p, const uint8_t *font, uint8_t scale) {
+    c->display=p;
+    c->font=font;
+    c->scale=scale;
+    c->advance=(font[1]+font[2])*scale;
+    c->line_pages=(font[0]*scale+7)>>3;
+    if(scale==0 || c->advance==0 || c->line_pages>SSD1306_PAGES(p))
+        return false;
 
-    p->buffer[x+p->width*(y>>3)]&=~(0x1<<(y&0x07));
+    c->cols=SSD1306_WIDTH(p)/c->advance;
+    c->rows=SSD1306_PAGES(p)/c->line_pages;
+    if(c->cols==0)
+        return false;
+
+    // the start line wraps at the end of the 64 rows of display ram, so lines can only rotate
+    // through it if the display shows all of it and no line straddles the wrap
+    c->ring=SSD1306_PAGES(p)==8 && 8%c->line_pages==0;
+
+    // an earlier console may have left the start line anywhere
+    const uint8_t cmd=SET_DISP_START_LINE;
+    ssd1306_write_commands(p, &cmd, 1);
+    c->top=0;
+    c->col=0;
+    c->row=0;
+    ssd1306_clear(p);
+    return true;
 }
 
-void ssd1306_draw_pixel(ssd1306_t *p, uint32_t x, uint32_t y) {
-    if(x>=p->width || y>=p->height) return;
+void ssd1306_console_clear(ssd1306_console_t *c) {
+    ssd1306_t *p=c->display;
 
-    p->buffer[x+p->width*(y>>3)]|=0x1<<(y&0x07); // y>>3==y/8 && y&0x7==y%8
+    c->col=0;
+    c->row=0;
+    if(c->ring && c->top!=0) {
+        const uint8_t cmd=SET_DISP_START_LINE;
+        ssd1306_write_commands(p, &cmd, 1);
+    }
+    c->top=0;
+    ssd1306_clear(p);
 }
 
-void ssd1306_draw_line(ssd1306_t *p, int32_t x1, int32_t y1, int32_t x2, int32_t y2) {
-    if(x1>x2) {
-        swap(&x1, &x2);
-        swap(&y1, &y2);
+static void ssd1306_console_newline(ssd1306_console_t *c) {
+    ssd1306_t *p=c->display;
+
+    // show the finished line, so the dirty region never spans more than one line
+    // and in particular never the wrap of the ring
+    ssd1306_show(p);
+
+    c->col=0;
+    if(c->row+1<c->rows) {
+        ++c->row;
+        return;
     }
 
-    if(x1==x2) {
-        if(y1>y2)
-            swap(&y1, &y2);
-        for(int32_t i=y1; i<=y2; ++i)
-            ssd1306_draw_pixel(p, x1, i);
+    const size_t line=c->line_pages*SSD1306_WIDTH(p);
+    if(c->ring) {
+        // the top line becomes the new bottom line
+        const uint32_t page=c->top;
+        c->top=(c->top+c->line_pages)%SSD1306_PAGES(p);
+
+        memset(p->buffer+page*SSD1306_WIDTH(p), 0, line);
+        ssd1306_mark_dirty(p, 0, SSD1306_WIDTH(p)-1, page, page+c->line_pages-1);
+
+        const uint8_t cmd=SET_DISP_START_LINE | (c->top<<3);
+        ssd1306_write_commands(p, &cmd, 1);
+    } else {
+        memmove(p->buffer, p->buffer+line, (c->rows-1)*line);
+        memset(p->buffer+(c->rows-1)*line, 0, line);
+        ssd1306_mark_dirty(p, 0, SSD1306_WIDTH(p)-1, 0, c->rows*c->line_pages-1);
+    }
+}
+
+// clears the character cell under the cursor
+static inline void ssd1306_console_erase(ssd1306_console_t *c) {
+    ssd1306_clear_square(c->display, c->col*c->advance, ssd1306_console_page(c, c->row)<<3, c->advance, c->line_pages<<3);
+}
+
+void ssd1306_console_putc(ssd1306_console_t *c, char ch) {
+    switch(ch) {
+    case '\n':
+        ssd1306_console_newline(c);
+        return;
+    case '\r':
+        c->col=0;
+        return;
+    case '\b':
+        if(c->col>0) {
+            --c->col;
+            ssd1306_console_erase(c);
+        }
+        return;
+    case '\t':
+        c->col=(c->col/SSD1306_CONSOLE_TAB+1)*SSD1306_CONSOLE_TAB;
+        if(c->col>c->cols)
+            c->col=c->cols;
         return;
+    case '\f':
+        ssd1306_console_clear(c);
+        return;
+    default:
+        break;
     }
 
-    float m=(float) (y2-y1) / (float) (x2-x1);
+    if((uint8_t) ch<0x20)
+        return;
+
+    // wrapping is deferred to the next character, so a full line does not scroll by itself
+    if(c->col>=c->cols)
+        ssd1306_console_newline(c);
+
+    ssd1306_console_erase(c);
+    ssd1306_draw_char_with_font(c->display, c->col*c->advance, ssd1306_console_page(c, c->row)<<3, c->scale, c->font, ch);
+    ++c->col;
+}
+
+void ssd1306_console_write(ssd1306_console_t *c, const char *s) {
+    while(*s)
+        ssd1306_console_putc(c, *(s++));
+    ssd1306_show(c->display);
+}
 
-    for(int32_t i=x1; i<=x2; ++i) {
-        float y=m*(float) (i-x1)+(float) y1;
-        ssd1306_draw_pixel(p, i, (uint32_t) y);
+// combines n sprite bytes with a row of the buffer, sprite bytes are shifted by shift (right if negative)
+static void ssd1306_blit_span(uint8_t *dst, const uint8_t *src, uint32_t n, int32_t shift, uint8_t mask, ssd1306_blit_mode_t mode) {
+    const uint32_t left=shift>=0?shift:0, right=shift<0?-shift:0;
+#define SHIFTED(b) ((uint8_t) (((b)<<left)>>right)&mask)
+    switch(mode) {
+    case SSD1306_BLIT_OR:
+        for(uint32_t i=0; i<n; ++i)
+            dst[i]|=SHIFTED(src[i]);
+        break;
+    case SSD1306_BLIT_AND_NOT:
+        for(uint32_t i=0; i<n; ++i)
+            dst[i]&=~SHIFTED(src[i]);
+        break;
+    case SSD1306_BLIT_XOR:
+        for(uint32_t i=0; i<n; ++i)
+            dst[i]^=SHIFTED(src[i]);
+        break;
+    case SSD1306_BLIT_COPY:
+        if(shift==0 && mask==0xff) {
+            memcpy(dst, src, n);
+            break;
+        }
+        for(uint32_t i=0; i<n; ++i)
+            dst[i]=(dst[i]&~mask)|SHIFTED(src[i]);
+        break;
     }
+#undef SHIFTED
 }
 
-void ssd1306_clear_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
-    for(uint32_t i=0; i<width; ++i)
-        for(uint32_t j=0; j<height; ++j)
-            ssd1306_clear_pixel(p, x+i, y+j);
+void ssd1306_blit_mode(ssd1306_t *disp, const char* sprite,
+                       uint32_t sprite_height, uint32_t sprite_width,
+                       int32_t start_col, int32_t start_row, ssd1306_blit_mode_t mode) {
+    // visible part of the sprite in display coordinates
+    const int64_t first_col=start_col<0?0:start_col, first_row=start_row<0?0:start_row;
+    int64_t last_col=(int64_t) start_col+sprite_width-1, last_row=(int64_t) start_row+sprite_height-1;
+    if(last_col>=SSD1306_WIDTH(disp)) last_col=SSD1306_WIDTH(disp)-1;
+    if(last_row>=SSD1306_HEIGHT(disp)) last_row=SSD1306_HEIGHT(disp)-1;
+    if(first_col>last_col || first_row>last_row)
+        return;
+
+    const uint8_t *src=(const uint8_t *) sprite+(first_col-start_col);
+    const uint32_t n=last_col-first_col+1;
+    const uint32_t sprite_pages=(sprite_height+7)>>3;
+    const int32_t shift=start_row&7;
+    const int32_t base_page=(start_row-shift)/8;
+    uint8_t *dst=(uint8_t *) disp->buffer+first_col;
+
+    for(uint32_t sp=0; sp<sprite_pages; ++sp, src+=sprite_width) {
+        const uint8_t mask=(sp==sprite_pages-1 && (sprite_height&7))?0xff>>(8-(sprite_height&7)):0xff;
+        const int32_t page=base_page+(int32_t) sp;
+
+        if(page>=SSD1306_PAGES(disp))
+            break;
+
+        if(page>=0)
+            ssd1306_blit_span(dst+page*SSD1306_WIDTH(disp), src, n, shift, (uint8_t) (mask<<shift), mode);
+
+        // rows that spill into the next page
+        if(shift && page+1>=0 && page+1<SSD1306_PAGES(disp))
+            ssd1306_blit_span(dst+(page+1)*SSD1306_WIDTH(disp), src, n, shift-8, mask>>(8-shift), mode);
+    }
+
+    ssd1306_mark_dirty(disp, first_col, last_col, first_row>>3, last_row>>3);
 }
 
-void ssd1306_draw_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
-    for(uint32_t i=0; i<width; ++i)
-        for(uint32_t j=0; j<height; ++j)
-            ssd1306_draw_pixel(p, x+i, y+j);
+void ssd1306_blit(ssd1306_t *disp, const char* sprite,
+                  uint32_t sprite_height, uint32_t sprite_width,
+                  int32_t start_col, int32_t start_row) {
+    ssd1306_blit_mode(disp, sprite, sprite_height, sprite_width, start_col, start_row, SSD1306_BLIT_OR);
 }
 
-void ssd1306_draw_empty_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
-    ssd1306_draw_line(p, x, y, x+width, y);
-    ssd1306_draw_line(p, x, y+height, x+width, y+height);
-    ssd1306_draw_line(p, x, y, x, y+height);
-    ssd1306_draw_line(p, x+width, y, x+width, y+height);
+// replaces the masked bits of n buffer bytes with the shifted value v
+static void ssd1306_fill_span(uint8_t *dst, uint8_t v, uint32_t n, int32_t shift, uint8_t mask) {
+    const uint8_t bits=(uint8_t) (shift>=0?v<<shift:v>>-shift)&mask;
+
+    if(mask==0xff) {
+        memset(dst, bits, n);
+        return;
+    }
+
+    for(uint32_t i=0; i<n; ++i)
+        dst[i]=(dst[i]&~mask)|bits;
 }
 
-void ssd1306_draw_char_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *font, char c) {
-    if(c<font[3]||c>font[4])
+// copies n image bytes (or n times v if src is NULL) of one image page to column x, bit 0 on row y
+static void ssd1306_image_span(ssd1306_t *p, const uint8_t *src, uint8_t v, uint32_t n, int32_t x, int32_t y, uint8_t mask) {
+    if(x<0) {
+        if((uint32_t) -x>=n)
+            return;
+        if(src)
+            src+=-x;
+        n-=-x;
+        x=0;
+    }
+    if(x>=SSD1306_WIDTH(p))
         return;
+    if(n>(uint32_t) (SSD1306_WIDTH(p)-x))
+        n=SSD1306_WIDTH(p)-x;
 
-    uint32_t parts_per_line=(font[0]>>3)+((font[0]&7)>0);
-    for(uint8_t w=0; w<font[1]; ++w) { // width
-        uint32_t pp=(c-font[3])*font[1]*parts_per_line+w*parts_per_line+5;
-        for(uint32_t lp=0; lp<parts_per_line; ++lp) {
-            uint8_t line=font[pp];
+    const int32_t shift=y&7;
+    const int32_t page=(y-shift)/8;
+    uint8_t *dst=(uint8_t *) p->buffer+x;
 
-            for(int8_t j=0; j<8; ++j, line>>=1) {
-                if(line & 1)
-                    ssd1306_draw_square(p, x+w*scale, y+((lp<<3)+j)*scale, scale, scale);
-            }
+    if(page>=0 && page<SSD1306_PAGES(p)) {
+        if(src)
+            ssd1306_blit_span(dst+page*SSD1306_WIDTH(p), src, n, shift, (uint8_t) (mask<<shift), SSD1306_BLIT_COPY);
+        else
+            ssd1306_fill_span(dst+page*SSD1306_WIDTH(p), v, n, shift, (uint8_t) (mask<<shift));
+    }
+
+    if(shift && page+1>=0 && page+1<SSD1306_PAGES(p)) {
+        if(src)
+            ssd1306_blit_span(dst+(page+1)*SSD1306_WIDTH(p), src, n, shift-8, mask>>(8-shift), SSD1306_BLIT_COPY);
+        else
+            ssd1306_fill_span(dst+(page+1)*SSD1306_WIDTH(p), v, n, shift-8, mask>>(8-shift));
+    }
+}
+
+/*
+ * decodes a run-length encoded page image straight into the buffer. control bytes below 0x80
+ * are followed by control+1 literal bytes, others by one byte that is repeated (control&0x7f)+3 times
+ */
+static void ssd1306_draw_image_rle(ssd1306_t *p, const uint8_t *data, uint32_t width, uint32_t height, int32_t x, int32_t y) {
+    const uint32_t pages=(height+7)>>3;
+    const uint8_t last_mask=(height&7)?0xff>>(8-(height&7)):0xff;
+    uint32_t col=0, page=0;
+
+    while(page<pages && y+(int32_t) (page<<3)<SSD1306_HEIGHT(p)) {
+        const uint8_t control=*(data++);
+        const uint8_t *literal=NULL;
+        uint8_t v=0;
+        uint32_t n;
+
+        if(control&0x80) {
+            n=(control&0x7f)+3;
+            v=*(data++);
+        } else {
+            n=control+1;
+            literal=data;
+            data+=n;
+        }
 
-            ++pp;
+        // runs may continue on the next page
+        while(n && page<pages) {
+            const uint32_t k=n<width-col?n:width-col;
+            ssd1306_image_span(p, literal, v, k, x+col, y+(page<<3), page==pages-1?last_mask:0xff);
+
+            if(literal)
+                literal+=k;
+            n-=k;
+            if((col+=k)==width) {
+                col=0;
+                ++page;
+            }
         }
     }
 }
 
-void ssd1306_draw_string_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *font, const char *s) {
-    for(int32_t x_n=x; *s; x_n+=(font[1]+font[2])*scale) {
-        ssd1306_draw_char_with_font(p, x_n, y, scale, font, *(s++));
+void ssd1306_draw_image(ssd1306_t *p, const uint8_t *image, int32_t x, int32_t y) {
+    const uint32_t width=image[0], height=image[1];
+
+    switch(image[2]) {
+    case SSD1306_IMAGE_PAGES:
+        ssd1306_blit_mode(p, (const char *) image+3, height, width, x, y, SSD1306_BLIT_COPY);
+        return;
+    case SSD1306_IMAGE_RLE:
+        ssd1306_draw_image_rle(p, image+3, width, height, x, y);
+        break;
+    default: // unknown format
+        return;
     }
+
+    const int64_t first_col=x<0?0:x, first_row=y<0?0:y;
+    int64_t last_col=(int64_t) x+width-1, last_row=(int64_t) y+height-1;
+    if(last_col>=SSD1306_WIDTH(p)) last_col=SSD1306_WIDTH(p)-1;
+    if(last_row>=SSD1306_HEIGHT(p)) last_row=SSD1306_HEIGHT(p)-1;
+    if(first_col<=last_col && first_row<=last_row)
+        ssd1306_mark_dirty(p, first_col, last_col, first_row>>3, last_row>>3);
 }
 
 static inline uint32_t ssd1306_bmp_get_val(const uint8_t *data, const size_t offset, uint8_t size) {
@@ -332,65 +1791,389 @@ inline void ssd1306_bmp_show_image(ssd1306_t *p, const uint8_t *data, const long
     ssd1306_bmp_show_image_with_offset(p, data, size, 0, 0);
 }
 
-#ifdef SSD1306_USE_DMA
-void copy_to_dma_tx(ssd1306_t *disp) {
-    disp->dma_tx_buffer[0] = 1u << I2C_IC_DATA_CMD_RESTART_LSB | 0x0040;
-    for (int i = 0; i < disp->bufsize-1; i++) {
-        disp->dma_tx_buffer[i+1] =  disp->buffer[i];
+// collects the window, all windows of a show are handed to the transport together
+static void ssd1306_queue_window(ssd1306_t *p, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1) {
+    if(p->tx_windows<SSD1306_WINDOWS) {
+        p->tx_window[p->tx_windows++]=(ssd1306_window_t) {x0, x1, page0, page1};
+        return;
     }
-    disp->dma_tx_buffer[disp->bufsize] = (1u << I2C_IC_DATA_CMD_STOP_LSB) | disp->buffer[disp->bufsize-1];
+
+    // out of windows, grow the last one to cover the new one as well
+    ssd1306_window_t *w=&p->tx_window[SSD1306_WINDOWS-1];
+    if(x0<w->x0) w->x0=x0;
+    if(x1>w->x1) w->x1=x1;
+    if(page0<w->page0) w->page0=page0;
+    if(page1>w->page1) w->page1=page1;
+}
+
+// queues the window and records it as the new content of the display ram
+static void ssd1306_flush_window(ssd1306_t *p, uint8_t *src, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1) {
+    ssd1306_queue_window(p, x0, x1, page0, page1);
+
+    const size_t len=x1-x0+1;
+    p->flush_bytes+=len*(page1-page0+1);
+
+    if(p->shadow!=NULL) {
+        for(uint32_t page=page0; page<=page1; ++page)
+            memcpy(p->shadow+page*SSD1306_WIDTH(p)+x0, src+page*SSD1306_WIDTH(p)+x0, len);
+    }
+}
+
+typedef uint32_t __attribute__((__may_alias__)) ssd1306_word_t;
+
+// returns the first column in [x, end) where a and b differ, end if there is none
+static inline uint32_t ssd1306_next_diff(const uint8_t *a, const uint8_t *b, uint32_t x, uint32_t end) {
+    // a and b are equally aligned, so once a is word aligned both can be compared a word at a time
+    for(; x<end && ((uintptr_t) (a+x)&3); ++x)
+        if(a[x]!=b[x])
+            return x;
+
+    for(; x+4<=end; x+=4)
+        if(*(const ssd1306_word_t *) (a+x)!=*(const ssd1306_word_t *) (b+x))
+            break;
+
+    for(; x<end; ++x)
+        if(a[x]!=b[x])
+            return x;
+
+    return end;
+}
+
+// sends only the bytes of the window that differ from the shadow copy
+static void ssd1306_flush_diff(ssd1306_t *p, uint8_t *src, ssd1306_window_t w) {
+    // pending window, merged with the following runs as long as that is cheaper than a new window
+    uint32_t wx0=0, wx1=0, wp0=0, wp1=0;
+    bool pending=false;
+
+    for(uint32_t page=w.page0; page<=w.page1; ++page) {
+        const uint8_t *row=src+page*SSD1306_WIDTH(p);
+        const uint8_t *shadow_row=p->shadow+page*SSD1306_WIDTH(p);
+        const uint32_t end=w.x1+1;
+
+        for(uint32_t x=ssd1306_next_diff(row, shadow_row, w.x0, end); x<end;) {
+            uint32_t r0=x, r1=x;
+            // extend the run over unchanged gaps smaller than the cost of a new window
+            while((x=ssd1306_next_diff(row, shadow_row, r1+1, end))<end && x-r1<=SSD1306_WINDOW_COST)
+                r1=x;
+
+            if(pending) {
+                if(wp1==page && r0>=wx0 && r1<=wx1) // already covered by the pending window
+                    continue;
+
+                uint32_t u0=r0<wx0?r0:wx0, u1=r1>wx1?r1:wx1;
+                int32_t waste=(int32_t) ((u1-u0+1)*(page-wp0+1)-(wx1-wx0+1)*(wp1-wp0+1)-(r1-r0+1));
+
+                if((wp1==page-1 || wp1==page) && waste<=SSD1306_WINDOW_COST) {
+                    wx0=u0;
+                    wx1=u1;
+                    wp1=page;
+                    continue;
+                }
+
+                ssd1306_flush_window(p, src, wx0, wx1, wp0, wp1);
+            }
+
+            wx0=r0;
+            wx1=r1;
+            wp0=wp1=page;
+            pending=true;
+        }
+    }
+
+    if(pending)
+        ssd1306_flush_window(p, src, wx0, wx1, wp0, wp1);
+}
+
+void ssd1306_set_shadow(ssd1306_t *p, uint8_t *shadow) {
+    p->shadow=shadow;
+    p->shadow_valid=false;
+}
+
+static inline ssd1306_window_t ssd1306_dirty_window(ssd1306_t *p) {
+    return (ssd1306_window_t) {p->dirty_x0, p->dirty_x1, p->dirty_p0, p->dirty_p1};
+}
+
+// sends the window of src, e.g. the dirty region of the display buffer or the front buffer
+static void ssd1306_flush(ssd1306_t *p, uint8_t *src, ssd1306_window_t w) {
+    p->flush_bytes=0;
+
+    if(w.x0>w.x1)
+        return;
+
+    if(p->shadow==NULL) {
+        ssd1306_flush_window(p, src, w.x0, w.x1, w.page0, w.page1);
+    } else if(!p->shadow_valid) {
+        // the display ram content is not known yet, so send everything once
+        ssd1306_flush_window(p, src, 0, SSD1306_WIDTH(p)-1, 0, SSD1306_PAGES(p)-1);
+        p->shadow_valid=true;
+    } else {
+        ssd1306_flush_diff(p, src, w);
+    }
+}
+
+// queues the windows of the region of src and hands them to the transport
+static void ssd1306_send(ssd1306_t *p, uint8_t *src, ssd1306_window_t w, ssd1306_callback_t callback, void *ctx) {
+    p->tx_callback=callback;
+    p->tx_ctx=ctx;
+    p->tx_windows=0;
+    p->tx_src=src;
+
+    ssd1306_flush(p, src, w);
+    ssd1306_stats_start(p);
+
+    if(p->tx_windows)
+        p->transport->windows(p);
+    else
+        ssd1306_transport_done(p, PICO_OK);
 }
-#endif
 
 #ifdef SSD1306_USE_DMA
+
+bool ssd1306_show_async(ssd1306_t *p, ssd1306_callback_t callback, void *ctx) {
+    if(ssd1306_is_busy(p))
+        return false;
+
+    ssd1306_scroll_end(p);
+
+    // the transfer reads from the front buffer, so copy the dirty region over
+    if(p->dirty_x0<=p->dirty_x1) {
+        const size_t len=p->dirty_x1-p->dirty_x0+1;
+        for(uint32_t page=p->dirty_p0; page<=p->dirty_p1; ++page)
+            memcpy(p->front+page*SSD1306_WIDTH(p)+p->dirty_x0, p->buffer+page*SSD1306_WIDTH(p)+p->dirty_x0, len);
+    }
+
+    // the callback may start the next show already
+    const ssd1306_window_t w=ssd1306_dirty_window(p);
+    ssd1306_mark_clean(p);
+    ssd1306_send(p, p->front, w, callback, ctx);
+    return true;
+}
+
+bool ssd1306_is_busy(ssd1306_t *p) {
+    return p->transport->busy!=NULL && p->transport->busy(p);
+}
+
 void ssd1306_show(ssd1306_t *p) {
     // if there is already a transfer running, wait until it has completed
-    dma_channel_wait_for_finish_blocking(p->dma_channel);
-    copy_to_dma_tx(p);
-    // now set the address of the display that we want to write to
-    p->i2c_i->hw->enable = 0;
-    p->i2c_i->hw->tar = p->address;
-    p->i2c_i->hw->enable = 1;
-    uint8_t payload[]= {SET_COL_ADDR, 0, p->width-1, SET_PAGE_ADDR, 0, p->pages-1};
-    if(p->width==64) {
-        payload[1]+=32;
-        payload[2]+=32;
-    }
-
-    for(size_t i=0; i<sizeof(payload); ++i)
-        ssd1306_write(p, payload[i]);
-
-    // the things that are left to do is to set the read address, and set the transfer count
-    // (we are doing 16bit transfers that means the count equals the amount of bytes in the
-    // diplay buffer
-    dma_channel_config dma_config = dma_channel_get_default_config(p->dma_channel);
-    channel_config_set_transfer_data_size(&dma_config, DMA_SIZE_16);
-    channel_config_set_read_increment(&dma_config, true);
-    channel_config_set_write_increment(&dma_config, false);
-    // configure the i2c channel to cooperate with the dma engine
-    channel_config_set_dreq(&dma_config, i2c_get_dreq(p->i2c_i, true));
-    dma_channel_configure(
-        p->dma_channel,                        // Channel to be configured
-        &dma_config,                           // The configuration we just created
-        &i2c_get_hw(p->i2c_i)->data_cmd,       // The initial write address
-        p->dma_tx_buffer,                      // The initial read address
-        p->bufsize+1,                          // Number of transfers; in this case each is 2 byte.
-        true                                   // Start immediately.
-    );
+    ssd1306_wait(p);
+    ssd1306_show_async(p, NULL, NULL);
+}
+
+void ssd1306_present(ssd1306_t *p) {
+    // the front buffer may still be in use by the running transfer
+    ssd1306_wait(p);
+
+    uint8_t *front=p->buffer;
+    p->buffer=p->front;
+    p->front=front;
+
+    ssd1306_scroll_end(p);
+    const ssd1306_window_t w=ssd1306_dirty_window(p);
+    ssd1306_mark_clean(p);
+    ssd1306_send(p, p->front, w, NULL, NULL);
 }
 #else
 void ssd1306_show(ssd1306_t *p) {
-    uint8_t payload[]= {SET_COL_ADDR, 0, p->width-1, SET_PAGE_ADDR, 0, p->pages-1};
-    if(p->width==64) {
-        payload[1]+=32;
-        payload[2]+=32;
+    ssd1306_scroll_end(p);
+    const ssd1306_window_t w=ssd1306_dirty_window(p);
+    ssd1306_mark_clean(p);
+    ssd1306_send(p, p->buffer, w, NULL, NULL);
+}
+#endif
+
+// sends the window straight from the display buffer and waits until it is on the display
+static void ssd1306_show_window(ssd1306_t *p, ssd1306_window_t w) {
+    // a running transfer may still need the bus, the new one reads the buffer so it has to complete before returning
+    ssd1306_wait(p);
+    ssd1306_scroll_end(p);
+
+    // the dirty region can only be dropped if the window covers all of it
+    if(w.x0<=p->dirty_x0 && w.x1>=p->dirty_x1 && w.page0<=p->dirty_p0 && w.page1>=p->dirty_p1)
+        ssd1306_mark_clean(p);
+
+    ssd1306_send(p, p->buffer, w, NULL, NULL);
+    ssd1306_wait(p);
+}
+
+void ssd1306_show_region(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height) {
+    if(x>=SSD1306_WIDTH(p) || y>=SSD1306_HEIGHT(p) || width==0 || height==0) return;
+
+    if(width>SSD1306_WIDTH(p)-x) width=SSD1306_WIDTH(p)-x;
+    if(height>SSD1306_HEIGHT(p)-y) height=SSD1306_HEIGHT(p)-y;
+
+    ssd1306_show_window(p, (ssd1306_window_t) {x, x+width-1, y>>3, (y+height-1)>>3});
+}
+
+void ssd1306_show_pages(ssd1306_t *p, uint32_t first, uint32_t last) {
+    if(first>last || first>=SSD1306_PAGES(p)) return;
+
+    if(last>=SSD1306_PAGES(p)) last=SSD1306_PAGES(p)-1;
+
+    ssd1306_show_window(p, (ssd1306_window_t) {0, SSD1306_WIDTH(p)-1, first, last});
+}
+
+#ifdef SSD1306_USE_DMA
+void ssd1306_manager_init(ssd1306_manager_t *m) {
+    memset(m, 0, sizeof(*m));
+}
+
+bool ssd1306_manager_add(ssd1306_manager_t *m, ssd1306_t *p) {
+    if(m->count==SSD1306_MANAGER_DISPLAYS)
+        return false;
+
+    // only look for a free channel, ssd1306_init claims it
+    int channel=dma_claim_unused_channel(false);
+    if(channel<0)
+        return false;
+    dma_channel_unclaim(channel);
+    p->dma_channel=channel;
+
+    if(!ssd1306_init(p))
+        return false;
+
+    ssd1306_panel_t *panel=&m->panels[m->count++];
+    panel->display=p;
+    panel->manager=m;
+    return true;
+}
+
+static void ssd1306_manager_done(void *ctx, int result);
+
+static inline const void *ssd1306_bus(ssd1306_t *p) {
+    return p->transport->bus(p);
+}
+
+// starts the first panel from index i on that uses the given bus
+static void ssd1306_manager_start(ssd1306_manager_t *m, const void *bus, size_t i) {
+    for(; i<m->count; ++i) {
+        ssd1306_panel_t *panel=&m->panels[i];
+        if(ssd1306_bus(panel->display)!=bus)
+            continue;
+
+        panel->start_us=time_us_32()-m->start_us;
+        if(ssd1306_show_async(panel->display, ssd1306_manager_done, panel))
+            return;
+
+        // the bus is used by a display outside of the manager
+        panel->end_us=panel->start_us;
+        panel->result=PICO_ERROR_GENERIC;
+        panel->done=true;
+    }
+}
+
+// runs from the transport interrupt and starts the next panel on the same bus
+static void ssd1306_manager_done(void *ctx, int result) {
+    ssd1306_panel_t *panel=ctx;
+    ssd1306_manager_t *m=panel->manager;
+
+    panel->end_us=time_us_32()-m->start_us;
+    panel->result=result;
+    panel->done=true;
+
+    ssd1306_manager_start(m, ssd1306_bus(panel->display), panel-m->panels+1);
+}
+
+bool ssd1306_show_all(ssd1306_manager_t *m) {
+    bool ok=true;
+
+    for(size_t i=0; i<m->count; ++i) {
+        ssd1306_wait(m->panels[i].display);
+        m->panels[i].done=false;
+    }
+
+    m->start_us=time_us_32();
+    // one chain of transfers per bus, each starting at the first panel on that bus
+    for(size_t i=0; i<m->count; ++i) {
+        const void *bus=ssd1306_bus(m->panels[i].display);
+        size_t j=0;
+        while(j<i && ssd1306_bus(m->panels[j].display)!=bus)
+            ++j;
+        if(j==i)
+            ssd1306_manager_start(m, bus, i);
+    }
+
+    for(size_t i=0; i<m->count; ++i) {
+        while(!m->panels[i].done)
+            tight_loop_contents();
+        ok&=m->panels[i].result==PICO_OK;
+    }
+
+    m->total_us=time_us_32()-m->start_us;
+    return ok;
+}
+#endif
+
+#ifdef SSD1306_USE_PIPELINE
+bool ssd1306_pipeline_init(ssd1306_pipeline_t *pl, ssd1306_t *p, uint8_t *pool, size_t frames, ssd1306_queue_policy_t policy) {
+    // like the display buffer, every frame has a word in front for the control byte
+    if(!ssd1306_frame_pool_init(&pl->pool, pool+4, p->bufsize+4, frames, policy))
+        return false;
+
+    pl->display=p;
+    pl->buffer=p->buffer;
+    pl->stop=false;
+    pl->running=false;
+    p->buffer=ssd1306_frame_pool_current(&pl->pool);
+    return true;
+}
+
+// sends the whole frame, or only its changes if the display has a shadow
+static void ssd1306_pipeline_send(ssd1306_t *p, uint8_t *frame) {
+    const ssd1306_window_t all= {0, SSD1306_WIDTH(p)-1, 0, SSD1306_PAGES(p)-1};
+
+    ssd1306_scroll_end(p);
+    ssd1306_send(p, frame, all, NULL, NULL);
+    // the frame is handed back to core 0 once the transfer has read it
+    ssd1306_wait(p);
+}
+
+void ssd1306_pipeline_run(ssd1306_pipeline_t *pl) {
+    pl->running=true;
+
+    for(;;) {
+        int index=ssd1306_frame_pool_take(&pl->pool);
+        if(index<0) {
+            if(pl->stop)
+                break;
+            // woken by ssd1306_pipeline_submit and ssd1306_pipeline_stop
+            __wfe();
+            continue;
+        }
+
+        ssd1306_pipeline_send(pl->display, pl->pool.frames[index]);
+        ssd1306_frame_pool_release(&pl->pool, index);
     }
 
-    for(size_t i=0; i<sizeof(payload); ++i)
-        ssd1306_write(p, payload[i]);
+    pl->running=false;
+}
+
+static ssd1306_pipeline_t *ssd1306_core1_pipeline;
+
+static void ssd1306_core1_entry(void) {
+    ssd1306_pipeline_run(ssd1306_core1_pipeline);
+}
+
+void ssd1306_pipeline_launch(ssd1306_pipeline_t *pl) {
+    ssd1306_core1_pipeline=pl;
+    pl->running=true;
+    multicore_launch_core1(ssd1306_core1_entry);
+}
+
+void ssd1306_pipeline_submit(ssd1306_pipeline_t *pl) {
+    pl->display->buffer=ssd1306_frame_pool_submit(&pl->pool);
+    ssd1306_mark_clean(pl->display);
+    __sev();
+}
 
-    *(p->buffer-1)=0x40;
+void ssd1306_pipeline_stop(ssd1306_pipeline_t *pl) {
+    pl->stop=true;
+    __sev();
+    while(pl->running)
+        tight_loop_contents();
 
-    fancy_write(p->i2c_i, p->address, p->buffer-1, p->bufsize+1, "ssd1306_show");
+    // the buffer no longer matches the display ram
+    ssd1306_t *p=pl->display;
+    p->buffer=pl->buffer;
+    ssd1306_mark_dirty(p, 0, SSD1306_WIDTH(p)-1, 0, SSD1306_PAGES(p)-1);
 }
 #endif
@@ -33,6 +33,7 @@ SOFTWARE.
 #include <stdint.h>
 #include <pico/stdlib.h>
 #include <hardware/i2c.h>
+#include "font_struct.h"
 
 /**
 *	@brief defines commands used in ssd1306
@@ -54,21 +55,135 @@ typedef enum {
     SET_DISP_CLK_DIV = 0xD5,
     SET_PRECHARGE = 0xD9,
     SET_VCOM_DESEL = 0xDB,
-    SET_CHARGE_PUMP = 0x8D
+    SET_CHARGE_PUMP = 0x8D,
+    SET_HORIZ_SCROLL = 0x26,
+    SET_VERT_HORIZ_SCROLL = 0x29,
+    SET_SCROLL = 0x2E,
+    SET_VERT_SCROLL_AREA = 0xA3
 } ssd1306_command_t;
 
+/**
+*	@brief direction of a hardware scroll
+*/
+typedef enum {
+    SSD1306_SCROLL_RIGHT = 0,
+    SSD1306_SCROLL_LEFT = 1
+} ssd1306_scroll_dir_t;
+
+/**
+*	@brief frames between two steps of a hardware scroll, as encoded by the controller
+*/
+typedef enum {
+    SSD1306_SCROLL_2_FRAMES = 0x07,
+    SSD1306_SCROLL_3_FRAMES = 0x04,
+    SSD1306_SCROLL_4_FRAMES = 0x05,
+    SSD1306_SCROLL_5_FRAMES = 0x00,
+    SSD1306_SCROLL_25_FRAMES = 0x06,
+    SSD1306_SCROLL_64_FRAMES = 0x01,
+    SSD1306_SCROLL_128_FRAMES = 0x02,
+    SSD1306_SCROLL_256_FRAMES = 0x03
+} ssd1306_scroll_speed_t;
+
+/**
+*	@brief column and page range sent to the display
+*/
+typedef struct {
+    uint8_t x0, x1;		/**< first and last column */
+    uint8_t page0, page1;	/**< first and last page */
+} ssd1306_window_t;
+
+/*
+ * defining SSD1306_FIXED_WIDTH and SSD1306_FIXED_HEIGHT builds the library for a single panel size:
+ * buffer indexing and clipping use constants instead of the fields of ssd1306_t and initializing
+ * a display of another size fails
+ */
+#if defined(SSD1306_FIXED_WIDTH)!=defined(SSD1306_FIXED_HEIGHT)
+#error "SSD1306_FIXED_WIDTH and SSD1306_FIXED_HEIGHT have to be defined together"
+#endif
+
+#ifndef SSD1306_WINDOWS
+/* number of address windows a single show can send, further windows are merged into the last one */
+#define SSD1306_WINDOWS 8
+#endif
+
+#ifdef SSD1306_USE_SPI
+#include "hardware/spi.h"
+
+/* cs_pin of a display whose chip select is tied low */
+#define SSD1306_NO_PIN 0xff
+#endif
+
+/**
+*	@brief called when a show has been sent, from interrupt context for asynchronous transports
+*
+*	@param[in] ctx : pointer passed along with the callback
+*	@param[in] result : PICO_OK on success, PICO_ERROR_GENERIC if the display did not acknowledge
+*/
+typedef void (*ssd1306_callback_t)(void *ctx, int result);
+
+struct ssd1306;
+
+/**
+*	@brief how commands and display data get to the display
+*
+*	windows sends the tx_windows windows of tx_window, reading the bytes
+*	from tx_src, and reports the end with ssd1306_transport_done. Blocking
+*	transports do all of that before returning, asynchronous ones return
+*	right away and report from an interrupt.
+*/
+typedef struct {
+    bool (*init)(struct ssd1306 *p);	/**< claims the hardware, may be NULL */
+    void (*deinit)(struct ssd1306 *p);	/**< releases the hardware, may be NULL */
+    void (*commands)(struct ssd1306 *p, const uint8_t *cmds, size_t len);	/**< sends commands once a running transfer has finished */
+    void (*windows)(struct ssd1306 *p);	/**< sends the queued windows */
+    bool (*busy)(struct ssd1306 *p);	/**< whether a transfer runs on the bus of the display, NULL if the transport blocks */
+    const void *(*bus)(struct ssd1306 *p);	/**< identifies the bus, displays on the same bus are sent one after another */
+} ssd1306_transport_t;
+
+/**
+*	@brief display ram written by ssd1306_memory_transport, to run the library without a display
+*/
+typedef struct {
+    uint8_t ram[8][128];	/**< display ram, page by page */
+    uint8_t col0, col1;		/**< column window */
+    uint8_t page0, page1;	/**< page window */
+    uint8_t col, page;		/**< address of the next data byte */
+    uint8_t command;		/**< last command */
+    uint8_t args;		/**< arguments of command still to come */
+    uint8_t arg[2];		/**< first arguments of command */
+    size_t command_bytes;	/**< command bytes received */
+    size_t data_bytes;		/**< data bytes received */
+    size_t transfers;		/**< transfers received, each starts with a control byte on i2c */
+} ssd1306_memory_t;
+
+#ifdef SSD1306_USE_DMA
+extern const ssd1306_transport_t ssd1306_i2c_dma_transport;	/**< i2c, data streamed by dma */
+#else
+extern const ssd1306_transport_t ssd1306_i2c_transport;	/**< i2c, blocking */
+#endif
+#ifdef SSD1306_USE_SPI
+extern const ssd1306_transport_t ssd1306_spi_transport;	/**< 4-wire spi, data streamed by dma in the dma build */
+#endif
+extern const ssd1306_transport_t ssd1306_memory_transport;	/**< writes into the ssd1306_memory_t in transport_ctx */
+
 #ifdef SSD1306_USE_DMA
 #include "hardware/dma.h"
+
+#ifndef SSD1306_DMA_CHUNK
+/* number of bytes queued per dma transfer, the chunk is refilled from the dma interrupt */
+#define SSD1306_DMA_CHUNK 32
+#endif
+
 /* construct and initialize the display struct used to generate the display output
  * at compile time. This allows omitting the code to define the variables at runtime
  * as all the details are known at compile time
  */
 #define CREATE_DISPLAY(width_, height_, I2C, address_, dma_channel_, external_vcc_, id) \
-    uint8_t display_buffer_ ## id[width_*height_];\
-    uint16_t dma_tx_bufferbuffer_ ## id[width_*height_+1];\
+    uint8_t display_buffer_ ## id[width_*height_/8] __attribute__((aligned(4)));\
+    uint8_t display_front_ ## id[width_*height_/8] __attribute__((aligned(4)));\
     ssd1306_t display_ ## id = {\
-	.dma_tx_buffer = dma_tx_bufferbuffer_ ## id,\
 	.buffer = display_buffer_ ## id,\
+	.front = display_front_ ## id,\
 	.bufsize = width_ * height_ / 8,\
 	.width = width_,\
 	.height = height_,\
@@ -77,27 +192,134 @@ typedef enum {
 	.dma_channel = dma_channel_,\
 	.external_vcc = external_vcc_,\
 	.i2c_i = I2C,\
+	.transport = &ssd1306_i2c_dma_transport,\
+	.dirty_x0 = 0,\
+	.dirty_x1 = width_ - 1,\
+	.dirty_p0 = 0,\
+	.dirty_p1 = height_ / 8 - 1,\
+    }
+
+#ifdef SSD1306_USE_SPI
+/* like CREATE_DISPLAY for a display on 4-wire spi, cs_pin_ may be SSD1306_NO_PIN */
+#define CREATE_SPI_DISPLAY(width_, height_, SPI, dc_pin_, cs_pin_, dma_channel_, external_vcc_, id) \
+    uint8_t display_buffer_ ## id[width_*height_/8] __attribute__((aligned(4)));\
+    uint8_t display_front_ ## id[width_*height_/8] __attribute__((aligned(4)));\
+    ssd1306_t display_ ## id = {\
+	.buffer = display_buffer_ ## id,\
+	.front = display_front_ ## id,\
+	.bufsize = width_ * height_ / 8,\
+	.width = width_,\
+	.height = height_,\
+	.pages = height_ / 8,\
+	.dma_channel = dma_channel_,\
+	.external_vcc = external_vcc_,\
+	.spi = SPI,\
+	.dc_pin = dc_pin_,\
+	.cs_pin = cs_pin_,\
+	.transport = &ssd1306_spi_transport,\
+	.dirty_x0 = 0,\
+	.dirty_x1 = width_ - 1,\
+	.dirty_p0 = 0,\
+	.dirty_p1 = height_ / 8 - 1,\
     }
 #endif
 
+/* like CREATE_DISPLAY for a display without hardware, written by ssd1306_memory_transport into
+ * the ssd1306_memory_t pointed to by memory_
+ */
+#define CREATE_MEMORY_DISPLAY(width_, height_, memory_, id) \
+    uint8_t display_buffer_ ## id[width_*height_/8] __attribute__((aligned(4)));\
+    uint8_t display_front_ ## id[width_*height_/8] __attribute__((aligned(4)));\
+    ssd1306_t display_ ## id = {\
+	.buffer = display_buffer_ ## id,\
+	.front = display_front_ ## id,\
+	.bufsize = width_ * height_ / 8,\
+	.width = width_,\
+	.height = height_,\
+	.pages = height_ / 8,\
+	.transport = &ssd1306_memory_transport,\
+	.transport_ctx = memory_,\
+	.dirty_x0 = 0,\
+	.dirty_x1 = width_ - 1,\
+	.dirty_p0 = 0,\
+	.dirty_p1 = height_ / 8 - 1,\
+    }
+#endif
+
+#ifdef SSD1306_USE_STATS
+#ifndef SSD1306_STATS_BUCKETS
+/* number of buckets of the flush latency histogram */
+#define SSD1306_STATS_BUCKETS 8
+#endif
+
+#ifndef SSD1306_STATS_BUCKET_US
+/* upper bound of the first histogram bucket, every further bucket doubles it */
+#define SSD1306_STATS_BUCKET_US 512
+#endif
+
+/**
+*	@brief counters kept by a display built with SSD1306_USE_STATS
+*/
+typedef struct {
+    uint32_t flushes;		/**< shows that sent something */
+    uint32_t latency[SSD1306_STATS_BUCKETS];	/**< flushes by duration, bucket i below SSD1306_STATS_BUCKET_US<<i microseconds, the last one takes the rest */
+    uint64_t command_bytes;	/**< command bytes sent, without control bytes */
+    uint64_t data_bytes;	/**< display data bytes sent, without control bytes */
+    uint32_t nacks;		/**< writes the display did not acknowledge */
+    uint32_t timeouts;		/**< writes that timed out */
+    int last_error;		/**< error of the last failed write, PICO_OK if there was none */
+} ssd1306_stats_t;
+#endif
+
 /**
 *	@brief holds the configuration
 */
 #ifdef SSD1306_USE_DMA
-typedef struct {
-    volatile uint16_t *dma_tx_buffer;
-    volatile uint8_t *buffer;		/**< display buffer */
+typedef struct ssd1306 {
+    uint8_t *buffer;		/**< display buffer */
+    uint8_t *front;		/**< buffer the transfer reads from while buffer is drawn */
     const size_t bufsize;		/**< buffer size */
     const uint8_t width; 		/**< width of display */
     const uint8_t height;		/**< height of display */
     const uint8_t pages;		/**< stores pages of display (calculated on initialization*/
     const uint8_t address;		/**< i2c address of display*/
-    const uint dma_channel;
+    uint dma_channel;		/**< dma channel, assigned by ssd1306_manager_add for managed displays */
     const uint8_t external_vcc;	/**< whether display uses external vcc */ 
     i2c_inst_t *i2c_i;		/**< i2c connection instance */
+#ifdef SSD1306_USE_SPI
+    spi_inst_t *spi;		/**< spi connection instance */
+    uint8_t dc_pin;		/**< data/command pin */
+    uint8_t cs_pin;		/**< chip select pin or SSD1306_NO_PIN */
+#endif
+    const ssd1306_transport_t *transport;	/**< how bytes get to the display */
+    void *transport_ctx;	/**< data of the transport, e.g. the ssd1306_memory_t of ssd1306_memory_transport */
+    uint8_t dirty_x0;		/**< first changed column since last show (dirty_x0>dirty_x1 if unchanged) */
+    uint8_t dirty_x1;		/**< last changed column since last show */
+    uint8_t dirty_p0;		/**< first changed page since last show */
+    uint8_t dirty_p1;		/**< last changed page since last show */
+    uint8_t *shadow;		/**< copy of the display ram used to send only changed bytes, may be NULL */
+    bool shadow_valid;		/**< whether shadow holds the display ram content */
+    bool scrolling;		/**< whether a hardware scroll is running */
+    uint8_t scroll_page0;	/**< first page moved by the running scroll */
+    uint8_t scroll_page1;	/**< last page moved by the running scroll */
+    size_t flush_bytes;		/**< buffer bytes sent by the last show, compare with bufsize */
+#ifdef SSD1306_USE_STATS
+    ssd1306_stats_t stats;	/**< counters, read them with ssd1306_stats_snapshot */
+    uint32_t tx_start;		/**< time_us_32 at the start of the running transfer */
+#endif
+    uint8_t *tx_src;		/**< buffer the running transfer reads from */
+    ssd1306_window_t tx_window[SSD1306_WINDOWS];	/**< windows of the running transfer */
+    uint8_t tx_windows;		/**< number of windows of the running transfer */
+    ssd1306_callback_t tx_callback;	/**< called when the running transfer has finished, may be NULL */
+    void *tx_ctx;		/**< passed to tx_callback */
+    uint16_t dma_tx_buffer[SSD1306_DMA_CHUNK];	/**< i2c data_cmd words of the running dma transfer */
+    uint8_t tx_win;		/**< next window to queue */
+    uint8_t tx_x0, tx_x1;	/**< column window of the window being queued */
+    uint8_t tx_col, tx_page;	/**< next byte of the window being queued */
+    uint8_t tx_page1;		/**< last page of the window being queued */
 } ssd1306_t;
 #else
-typedef struct {
+typedef struct ssd1306 {
     size_t bufsize;		/**< buffer size */
     uint8_t *buffer;		/**< display buffer */
     uint8_t width; 		/**< width of display */
@@ -106,10 +328,83 @@ typedef struct {
     uint8_t address;		/**< i2c address of display*/
     i2c_inst_t *i2c_i;		/**< i2c connection instance */
     bool external_vcc;		/**< whether display uses external vcc */ 
+#ifdef SSD1306_USE_SPI
+    spi_inst_t *spi;		/**< spi connection instance */
+    uint8_t dc_pin;		/**< data/command pin */
+    uint8_t cs_pin;		/**< chip select pin or SSD1306_NO_PIN */
+#endif
+    const ssd1306_transport_t *transport;	/**< how bytes get to the display */
+    void *transport_ctx;	/**< data of the transport, e.g. the ssd1306_memory_t of ssd1306_memory_transport */
+    uint8_t dirty_x0;		/**< first changed column since last show (dirty_x0>dirty_x1 if unchanged) */
+    uint8_t dirty_x1;		/**< last changed column since last show */
+    uint8_t dirty_p0;		/**< first changed page since last show */
+    uint8_t dirty_p1;		/**< last changed page since last show */
+    uint8_t *shadow;		/**< copy of the display ram used to send only changed bytes, may be NULL */
+    bool shadow_valid;		/**< whether shadow holds the display ram content */
+    bool scrolling;		/**< whether a hardware scroll is running */
+    uint8_t scroll_page0;	/**< first page moved by the running scroll */
+    uint8_t scroll_page1;	/**< last page moved by the running scroll */
+    size_t flush_bytes;		/**< buffer bytes sent by the last show, compare with bufsize */
+#ifdef SSD1306_USE_STATS
+    ssd1306_stats_t stats;	/**< counters, read them with ssd1306_stats_snapshot */
+    uint32_t tx_start;		/**< time_us_32 at the start of the running transfer */
+#endif
+    uint8_t *tx_src;		/**< buffer the running transfer reads from */
+    ssd1306_window_t tx_window[SSD1306_WINDOWS];	/**< windows of the running transfer */
+    uint8_t tx_windows;		/**< number of windows of the running transfer */
+    ssd1306_callback_t tx_callback;	/**< called when the running transfer has finished, may be NULL */
+    void *tx_ctx;		/**< passed to tx_callback */
 } ssd1306_t;
 #endif
 
+#ifdef SSD1306_USE_PIPELINE
+#include "ssd1306_queue.h"
+
+/* bytes of the frame pool passed to ssd1306_pipeline_init, every frame is preceded by a word */
+#define SSD1306_PIPELINE_POOL_SIZE(width, height, frames) ((frames)*((width)*(height)/8+4))
+
+/**
+*	@brief frames rendered on core 0 and sent to the display from core 1
+*/
+typedef struct {
+    ssd1306_t *display;		/**< display, its transport is used by core 1 only */
+    ssd1306_frame_pool_t pool;	/**< frames and the queues between the cores */
+    uint8_t *buffer;		/**< display buffer before the pipeline was set up */
+    volatile bool stop;		/**< asks core 1 to return once the queue is empty */
+    volatile bool running;	/**< whether core 1 is in ssd1306_pipeline_run */
+} ssd1306_pipeline_t;
+#endif
+
 #ifdef SSD1306_USE_DMA
+#ifndef SSD1306_MANAGER_DISPLAYS
+/* number of displays a ssd1306_manager_t can drive */
+#define SSD1306_MANAGER_DISPLAYS 4
+#endif
+
+struct ssd1306_manager;
+
+/**
+*	@brief display driven by a manager together with the timing of its last show
+*/
+typedef struct {
+    ssd1306_t *display;		/**< managed display */
+    struct ssd1306_manager *manager;	/**< manager the display belongs to */
+    uint32_t start_us;		/**< start of the transfer, relative to the start of ssd1306_show_all */
+    uint32_t end_us;		/**< end of the transfer, relative to the start of ssd1306_show_all */
+    int result;			/**< PICO_OK or the error of the transfer */
+    volatile bool done;		/**< whether the transfer has finished */
+} ssd1306_panel_t;
+
+/**
+*	@brief set of displays refreshed together by ssd1306_show_all
+*/
+typedef struct ssd1306_manager {
+    ssd1306_panel_t panels[SSD1306_MANAGER_DISPLAYS];	/**< displays in the order they were added */
+    uint8_t count;		/**< number of displays */
+    uint32_t start_us;		/**< start of the last ssd1306_show_all */
+    uint32_t total_us;		/**< duration of the last ssd1306_show_all */
+} ssd1306_manager_t;
+
 bool ssd1306_init(ssd1306_t *p);
 #else
 /**
@@ -126,8 +421,51 @@ bool ssd1306_init(ssd1306_t *p);
 *	@retval false if initialization failed
 */
 bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address, i2c_inst_t *i2c_instance);
+
+/**
+*	@brief initialize display connected through the given transport
+*
+*	@param[in] p : pointer to instance of ssd1306_t
+*	@param[in] width : width of display
+*	@param[in] height : heigth of display
+*	@param[in] transport : transport, e.g. ssd1306_memory_transport
+*	@param[in] ctx : stored in transport_ctx for the transport
+*
+* 	@return bool.
+*	@retval true for Success
+*	@retval false if initialization failed
+*/
+bool ssd1306_init_transport(ssd1306_t *p, uint16_t width, uint16_t height, const ssd1306_transport_t *transport, void *ctx);
+
+#ifdef SSD1306_USE_SPI
+/**
+*	@brief initialize display connected through 4-wire spi
+*
+*	The spi instance has to be set up for mode 0 already.
+*
+*	@param[in] p : pointer to instance of ssd1306_t
+*	@param[in] width : width of display
+*	@param[in] height : heigth of display
+*	@param[in] spi_instance : instance of spi connection
+*	@param[in] dc_pin : data/command pin
+*	@param[in] cs_pin : chip select pin or SSD1306_NO_PIN
+*
+* 	@return bool.
+*	@retval true for Success
+*	@retval false if initialization failed
+*/
+bool ssd1306_init_spi(ssd1306_t *p, uint16_t width, uint16_t height, spi_inst_t *spi_instance, uint8_t dc_pin, uint8_t cs_pin);
+#endif
 #endif
 
+/**
+*	@brief report the end of the transfer of the queued windows, for implementations of ssd1306_transport_t
+*
+*	@param[in] p : instance of display
+*	@param[in] result : PICO_OK or the error of the transfer
+*/
+void ssd1306_transport_done(ssd1306_t *p, int result);
+
 /**
 *	@brief deinitialize display
 *
@@ -170,14 +508,298 @@ void ssd1306_contrast(ssd1306_t *p, uint8_t val);
 */
 void ssd1306_invert(ssd1306_t *p, uint8_t inv);
 
+/**
+	@brief start continuous horizontal hardware scroll
+
+	The controller moves the pages by one column every speed frames, on its
+	own and without any bus traffic. Running scrolls are stopped first.
+	Show the buffer before starting the scroll, ssd1306_show stops the
+	scroll before it writes to the display ram and resends the scrolled
+	pages. A reversed page range is swapped, pages past the last page of
+	the display are limited to it.
+
+	@param[in] p : instance of display
+	@param[in] dir : direction
+	@param[in] page0 : first page to scroll
+	@param[in] page1 : last page to scroll
+	@param[in] speed : frames between two steps
+
+*/
+void ssd1306_scroll_horizontal(ssd1306_t *p, ssd1306_scroll_dir_t dir, uint8_t page0, uint8_t page1,
+                               ssd1306_scroll_speed_t speed);
+
+/**
+	@brief start continuous vertical and horizontal hardware scroll
+
+	Like ssd1306_scroll_horizontal, every step additionally moves the rows
+	of the vertical scroll area (see ssd1306_scroll_area) up by offset rows.
+
+	@param[in] p : instance of display
+	@param[in] dir : horizontal direction
+	@param[in] page0 : first page to scroll horizontally
+	@param[in] page1 : last page to scroll horizontally
+	@param[in] speed : frames between two steps
+	@param[in] offset : rows moved per step, 1 to 63
+
+*/
+void ssd1306_scroll_diagonal(ssd1306_t *p, ssd1306_scroll_dir_t dir, uint8_t page0, uint8_t page1,
+                             ssd1306_scroll_speed_t speed, uint8_t offset);
+
+/**
+	@brief set rows moved by the vertical part of ssd1306_scroll_diagonal
+
+	@param[in] p : instance of display
+	@param[in] fixed_rows : rows at the top that stay in place
+	@param[in] rows : rows below them that scroll
+
+*/
+void ssd1306_scroll_area(ssd1306_t *p, uint8_t fixed_rows, uint8_t rows);
+
+/**
+	@brief stop a running hardware scroll
+
+	The scrolled pages are marked to be sent again by the next show, the
+	horizontal scroll moved their content in the display ram. A shadow set
+	with ssd1306_set_shadow no longer matches, so the next show sends the
+	whole buffer.
+
+	@param[in] p : instance of display
+
+*/
+void ssd1306_scroll_stop(ssd1306_t *p);
+
+/**
+	@brief send commands to display
+
+	All bytes are sent behind a single control byte, so a whole command
+	sequence costs one i2c transaction instead of one per byte. Arguments
+	of a command simply follow it in cmds.
+
+	@param[in] p : instance of display
+	@param[in] cmds : command bytes
+	@param[in] len : number of bytes in cmds
+
+*/
+void ssd1306_write_commands(ssd1306_t *p, const uint8_t *cmds, size_t len);
+
 /**
 	@brief display buffer, should be called on change
 
+	Only the columns and pages touched by the drawing functions since the
+	last call are sent to the display.
+
 	@param[in] p : instance of display
 
 */
 void ssd1306_show(ssd1306_t *p);
 
+#ifdef SSD1306_USE_DMA
+/**
+	@brief display buffer without waiting for the bus
+
+	Works like ssd1306_show, but the address commands and the data are sent
+	from the dma and i2c interrupts and the call returns immediately.
+	Drawing can continue right away. If nothing changed, callback is called
+	before returning.
+
+	@param[in] p : instance of display
+	@param[in] callback : called on completion or error, may be NULL
+	@param[in] ctx : passed to callback
+
+	@return bool.
+	@retval true if the transfer was started
+	@retval false if a transfer on the i2c bus of the display is still running
+*/
+bool ssd1306_show_async(ssd1306_t *p, ssd1306_callback_t callback, void *ctx);
+
+/**
+	@brief check for a running transfer
+
+	@param[in] p : instance of display
+
+	@return bool.
+	@retval true if a transfer on the i2c bus of the display is still running
+*/
+bool ssd1306_is_busy(ssd1306_t *p);
+#endif
+
+/**
+	@brief display a rectangle of the display buffer
+
+	For when the application knows what changed, e.g. a single widget.
+	The rectangle is rounded out to whole pages and sent directly from the
+	display buffer, independent of the tracked dirty region. The call
+	returns once the data is on the display, also with dma.
+
+	@param[in] p : instance of display
+	@param[in] x : x of the top left corner
+	@param[in] y : y of the top left corner
+	@param[in] width : width of the rectangle
+	@param[in] height : height of the rectangle
+*/
+void ssd1306_show_region(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+/**
+	@brief display whole pages of the display buffer
+
+	Works like ssd1306_show_region for the full width of pages first to last.
+
+	@param[in] p : instance of display
+	@param[in] first : first page
+	@param[in] last : last page, clipped to the display
+*/
+void ssd1306_show_pages(ssd1306_t *p, uint32_t first, uint32_t last);
+
+/**
+	@brief set shadow buffer used by ssd1306_show to send only changed bytes
+
+	The shadow keeps a copy of what was sent to the display. ssd1306_show
+	compares it with the display buffer and sends only the changed runs,
+	merged into a few address windows. The first show after this call
+	sends the whole buffer.
+
+	@param[in] p : instance of display
+	@param[in] shadow : word aligned buffer of bufsize bytes, NULL disables diffing
+
+*/
+void ssd1306_set_shadow(ssd1306_t *p, uint8_t *shadow);
+
+#ifdef SSD1306_USE_STATS
+/**
+	@brief copy the counters of the display
+
+	The counters of asynchronous transfers are updated from interrupts, the
+	copy is taken with interrupts disabled so it is consistent.
+
+	@param[in] p : instance of display
+	@param[out] stats : copy of the counters
+
+*/
+void ssd1306_stats_snapshot(ssd1306_t *p, ssd1306_stats_t *stats);
+
+/**
+	@brief set all counters of the display to zero
+
+	@param[in] p : instance of display
+
+*/
+void ssd1306_stats_reset(ssd1306_t *p);
+#endif
+
+#ifdef SSD1306_USE_DMA
+/**
+	@brief exchange display buffer and front buffer and send the new front buffer
+
+	The dma transfer streams straight from the front buffer, so drawing
+	into the buffer can continue right away and overlaps the transfer. A
+	transfer still running from an earlier call is waited for first.
+	Afterwards the buffer holds the frame presented before the last one,
+	so it has to be redrawn completely (e.g. starting with ssd1306_clear).
+
+	@param[in] p : instance of display
+
+*/
+void ssd1306_present(ssd1306_t *p);
+
+/**
+	@brief initialize manager without displays
+
+	@param[in] m : manager
+
+*/
+void ssd1306_manager_init(ssd1306_manager_t *m);
+
+/**
+	@brief add display to manager
+
+	The display gets an unused dma channel, its dma_channel from
+	CREATE_DISPLAY is ignored, and is initialized with ssd1306_init.
+
+	@param[in] m : manager
+	@param[in] p : display, not initialized yet
+
+	@return bool.
+	@retval true if the display was added
+	@retval false if the manager is full, no dma channel is free or initialization failed
+*/
+bool ssd1306_manager_add(ssd1306_manager_t *m, ssd1306_t *p);
+
+/**
+	@brief display buffers of all displays of the manager
+
+	Both i2c controllers are driven in parallel. Displays on the same bus
+	are sent back to back, the next one is started from the completion
+	interrupt of the previous one. Returns once all transfers have
+	finished, start_us, end_us and result of every panel describe the
+	transfers.
+
+	@param[in] m : manager
+
+	@return bool.
+	@retval true if all displays acknowledged their transfers
+	@retval false if a transfer failed
+*/
+bool ssd1306_show_all(ssd1306_manager_t *m);
+#endif
+
+#ifdef SSD1306_USE_PIPELINE
+/**
+	@brief set up pipeline for an initialized display
+
+	The display buffer is replaced by frames of the pool. After the
+	pipeline has been started, only core 1 talks to the display, so the
+	display must not be shown, powered or changed otherwise from core 0.
+	In the dma build initialize the display on core 1, its interrupts are
+	then handled there as well.
+
+	@param[in] pl : pipeline
+	@param[in] p : display
+	@param[in] pool : word aligned buffer of SSD1306_PIPELINE_POOL_SIZE(width, height, frames) bytes
+	@param[in] frames : number of frames, 2 (3 for SSD1306_QUEUE_LATEST) to SSD1306_QUEUE_FRAMES
+	@param[in] policy : what to do with frames when the display falls behind
+
+	@return bool.
+	@retval true for Success
+	@retval false if frames is out of range
+*/
+bool ssd1306_pipeline_init(ssd1306_pipeline_t *pl, ssd1306_t *p, uint8_t *pool, size_t frames, ssd1306_queue_policy_t policy);
+
+/**
+	@brief send submitted frames until ssd1306_pipeline_stop is called, runs on core 1
+
+	@param[in] pl : pipeline
+*/
+void ssd1306_pipeline_run(ssd1306_pipeline_t *pl);
+
+/**
+	@brief launch ssd1306_pipeline_run on core 1
+
+	@param[in] pl : pipeline
+*/
+void ssd1306_pipeline_launch(ssd1306_pipeline_t *pl);
+
+/**
+	@brief queue the frame drawn into the display buffer, replaces ssd1306_show on core 0
+
+	The display buffer is exchanged for a free frame holding an older
+	frame, so it has to be redrawn completely (e.g. starting with
+	ssd1306_clear). The policy sets what happens when no frame is free:
+	SSD1306_QUEUE_WAIT waits, SSD1306_QUEUE_DROP drops the new frame and
+	SSD1306_QUEUE_LATEST takes back the oldest queued frame, so the new
+	frame is always queued.
+
+	@param[in] pl : pipeline
+*/
+void ssd1306_pipeline_submit(ssd1306_pipeline_t *pl);
+
+/**
+	@brief wait until core 1 has sent the queued frames and give the display back to core 0
+
+	@param[in] pl : pipeline
+*/
+void ssd1306_pipeline_stop(ssd1306_pipeline_t *pl);
+#endif
+
 /**
 	@brief clear display buffer
 
@@ -268,6 +890,31 @@ void ssd1306_bmp_show_image_with_offset(ssd1306_t *p, const uint8_t *data, const
 */
 void ssd1306_bmp_show_image(ssd1306_t *p, const uint8_t *data, const long size);
 
+/**
+*	@brief formats of images drawn by ssd1306_draw_image
+*/
+typedef enum {
+    SSD1306_IMAGE_PAGES = 0,		/**< uncompressed, page-major like the display buffer */
+    SSD1306_IMAGE_RLE = 1		/**< page-major and run-length encoded */
+} ssd1306_image_format_t;
+
+/**
+	@brief draw image in page format
+
+	Images are created from monochrome bitmaps with `bin2c -p` (or `-r`
+	for run-length encoded images). They start with a three byte header
+	(width, height, format) followed by the pixel data in the layout of the
+	display buffer, so images placed on a page boundary are copied row by
+	row; encoded images are decoded in one pass straight into the buffer.
+	The image replaces the pixels it covers and is clipped to the display.
+
+	@param[in] p : instance of display
+	@param[in] image : image data (whole array)
+	@param[in] x : x position of the top left corner, may be negative
+	@param[in] y : y position of the top left corner, may be negative
+*/
+void ssd1306_draw_image(ssd1306_t *p, const uint8_t *image, int32_t x, int32_t y);
+
 /**
 	@brief draw char with given font
 
@@ -292,17 +939,161 @@ void ssd1306_draw_char_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t
 */
 void ssd1306_draw_string_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *font, const char *s );
 
+/**
+	@brief draw a glyph of a font descriptor
+
+	@param[in] p : instance of display
+	@param[in] x : x starting position of the glyph
+	@param[in] y : y starting position of the glyph
+	@param[in] scale : scale font to n times of original size (default should be 1)
+	@param[in] font : font, e.g. written by tools/fontconv
+	@param[in] c : unicode code point to draw
+
+	@return advance to the next glyph in pixels, 0 if the font has no glyph for c
+*/
+uint32_t ssd1306_draw_glyph(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const ssd1306_font_t *font, uint32_t c);
+
+/**
+	@brief draw text with a font descriptor
+
+	The text is decoded as UTF-8. Glyphs are placed by their advance, so
+	proportional fonts work, and corrected by the kerning pairs of the
+	font. Code points without a glyph are skipped, malformed sequences
+	are drawn as U+FFFD if the font has it.
+
+	@param[in] p : instance of display
+	@param[in] x : x starting position of text
+	@param[in] y : y starting position of text
+	@param[in] scale : scale font to n times of original size (default should be 1)
+	@param[in] font : font, e.g. written by tools/fontconv
+	@param[in] s : UTF-8 text to draw
+*/
+void ssd1306_draw_text(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const ssd1306_font_t *font, const char *s);
+
+/**
+	@brief width of text drawn with ssd1306_draw_text
+
+	@param[in] font : font
+	@param[in] scale : scale of the font
+	@param[in] s : UTF-8 text
+
+	@return sum of the advances and kerning corrections in pixels
+*/
+uint32_t ssd1306_text_width(const ssd1306_font_t *font, uint32_t scale, const char *s);
+
+/**
+*	@brief how a sprite is combined with the display buffer
+*/
+typedef enum {
+    SSD1306_BLIT_OR,		/**< set the pixels that are set in the sprite */
+    SSD1306_BLIT_AND_NOT,	/**< clear the pixels that are set in the sprite */
+    SSD1306_BLIT_XOR,		/**< invert the pixels that are set in the sprite */
+    SSD1306_BLIT_COPY		/**< replace all pixels covered by the sprite */
+} ssd1306_blit_mode_t;
+
 /**
 	@brief Blit a sprite into the display buffer
 
+	The sprite is stored page-major like the display buffer: byte
+	sprite[page*sprite_width+col] holds the rows page*8 to page*8+7 of
+	column col, with the top row in bit 0. The sprite is clipped to the
+	display and or-ed into the buffer.
+
 	@param[in] disp : instance of display with display buffer
 	@param[in] sprite : the buffer containing the sprite (padded if necessary)
 	@param[in] sprite_height : the height of the sprite in pixels
 	@param[in] sprite_width : the width of the sprite in pixels (number of columns)
-	@param[in] start_col : the column on the display containing the top left corner of the sprite
-	@param[in] start_row : the row containing the top left corner of the sprite
+	@param[in] start_col : the column on the display containing the top left corner of the sprite, may be negative
+	@param[in] start_row : the row containing the top left corner of the sprite, may be negative
  */
 void ssd1306_blit(ssd1306_t *disp, const char* sprite,
 		  uint32_t sprite_height, uint32_t sprite_width,
-		  uint32_t start_col, uint32_t start_row);
+		  int32_t start_col, int32_t start_row);
+
+/**
+	@brief Blit a sprite into the display buffer with the given mode
+
+	Same as ssd1306_blit, but the sprite is combined with the buffer as
+	selected by mode.
+
+	@param[in] disp : instance of display with display buffer
+	@param[in] sprite : the buffer containing the sprite (padded if necessary)
+	@param[in] sprite_height : the height of the sprite in pixels
+	@param[in] sprite_width : the width of the sprite in pixels (number of columns)
+	@param[in] start_col : the column on the display containing the top left corner of the sprite, may be negative
+	@param[in] start_row : the row containing the top left corner of the sprite, may be negative
+	@param[in] mode : how sprite and buffer are combined
+ */
+void ssd1306_blit_mode(ssd1306_t *disp, const char* sprite,
+		       uint32_t sprite_height, uint32_t sprite_width,
+		       int32_t start_col, int32_t start_row, ssd1306_blit_mode_t mode);
+
+/**
+*	@brief text console that scrolls by moving the display start line
+*
+*	On 64 pixel high displays the display ram is used as a ring of lines:
+*	a new line only clears and sends its own pages and scrolling only
+*	changes the start line, so a scrolled line costs one line of data
+*	(128 bytes for an 8 pixel font) instead of the whole frame. Other
+*	heights, and line heights that do not divide the 8 pages, move the
+*	buffer up instead and resend all lines.
+*
+*	The console owns the display while it is used: the buffer is laid
+*	out like the display ram, so other drawing would appear shifted by
+*	the start line.
+*/
+typedef struct {
+    ssd1306_t *display;		/**< display the console writes to */
+    const uint8_t *font;	/**< font of the text */
+    uint8_t scale;		/**< scale of the font */
+    uint8_t advance;		/**< width of a character cell */
+    uint8_t line_pages;		/**< pages of a line */
+    uint8_t cols;		/**< characters per line */
+    uint8_t rows;		/**< lines on the display */
+    uint8_t col;		/**< cursor column, cols if the next character wraps */
+    uint8_t row;		/**< cursor line, 0 is the top line on the display */
+    uint8_t top;		/**< first page of the top line in the display ram */
+    bool ring;			/**< whether the console scrolls with the start line */
+} ssd1306_console_t;
+
+/**
+*	@brief set up a console on display and clear it
+*
+*	Lines are ceil(font height*scale/8) pages high.
+*
+*	@param[out] c : console
+*	@param[in] p : instance of display
+*	@param[in] font : pointer to font
+*	@param[in] scale : scale of the font
+*
+*	@return false if not even a single character fits on the display
+*/
+bool ssd1306_console_init(ssd1306_console_t *c, ssd1306_t *p, const uint8_t *font, uint8_t scale);
+
+/**
+*	@brief clear the console and move the cursor to the top left
+*/
+void ssd1306_console_clear(ssd1306_console_t *c);
+
+/**
+*	@brief put a character at the cursor without showing it
+*
+*	Lines wrap at the right edge. Of the control characters '\n' starts a
+*	new line, '\r' returns to the start of the line, '\b' erases the
+*	character before the cursor, '\t' moves to the next multiple of 4
+*	columns and '\f' clears the console, the others are ignored.
+*	Finished lines are shown when the cursor leaves them.
+*
+*	@param[in] c : console
+*	@param[in] ch : character
+*/
+void ssd1306_console_putc(ssd1306_console_t *c, char ch);
+
+/**
+*	@brief put a string at the cursor and show it
+*
+*	@param[in] c : console
+*	@param[in] s : text, may contain the control characters of ssd1306_console_putc
+*/
+void ssd1306_console_write(ssd1306_console_t *c, const char *s);
 #endif
@@ -0,0 +1,253 @@
+/**
+* @file ssd1306_queue.h
+*
+* lock-free frame queue between a core that renders and a core that sends frames
+*
+* Only plain loads and stores are used, the cortex-m0+ has no atomic read-modify-write
+* instructions. The queues need acquire/release ordering, the lock that lets the producer
+* take back queued frames is Peterson's algorithm on sequentially consistent loads and
+* stores. The header does not depend on the pico sdk and compiles as c and c++, so the
+* queue can be run on the host as well.
+*/
+
+#ifndef _inc_ssd1306_queue
+#define _inc_ssd1306_queue
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef SSD1306_QUEUE_FRAMES
+/* maximum number of frames in a pool, has to be a power of two */
+#define SSD1306_QUEUE_FRAMES 8
+#endif
+
+#ifndef SSD1306_QUEUE_IDLE
+/* run while the producer waits for a free frame or either side for the lock */
+#define SSD1306_QUEUE_IDLE() do {} while(0)
+#endif
+
+/**
+*	@brief single producer single consumer ring of frame indices
+*/
+typedef struct {
+    uint8_t slots[SSD1306_QUEUE_FRAMES];	/**< frame indices */
+    uint32_t head;		/**< number of pushed indices, written by the producer */
+    uint32_t tail;		/**< number of popped indices, written by the consumer */
+} ssd1306_queue_t;
+
+/**
+*	@brief what ssd1306_frame_pool_submit does when the consumer falls behind
+*/
+typedef enum {
+    SSD1306_QUEUE_WAIT,		/**< wait for a free frame, every frame is presented */
+    SSD1306_QUEUE_DROP,		/**< drop the submitted frame if no frame is free */
+    SSD1306_QUEUE_LATEST,	/**< never wait and never lose the newest frame: if no frame is free the producer takes back the oldest queued one, the consumer skips to the newest queued frame, needs 3 frames */
+} ssd1306_queue_policy_t;
+
+/**
+*	@brief mutual exclusion of exactly one producer and one consumer without read-modify-write
+*/
+typedef struct {
+    uint32_t wants[2];		/**< side 0 (producer) or 1 (consumer) wants the lock */
+    uint32_t turn;		/**< side that yields if both want the lock */
+} ssd1306_queue_lock_t;
+
+/**
+*	@brief fixed pool of frames handed from producer to consumer and back
+*/
+typedef struct {
+    uint8_t *frames[SSD1306_QUEUE_FRAMES];	/**< frame buffers */
+    uint8_t count;		/**< number of frames */
+    uint8_t current;		/**< frame owned by the producer */
+    ssd1306_queue_policy_t policy;	/**< behaviour when the consumer falls behind */
+    ssd1306_queue_t ready;	/**< submitted frames, producer to consumer */
+    ssd1306_queue_t free;	/**< presented frames, consumer to producer */
+    ssd1306_queue_lock_t lock;	/**< guards taking frames from ready with SSD1306_QUEUE_LATEST, where both sides do */
+    uint32_t presented;		/**< frames sent by the consumer, written by the consumer */
+    uint32_t coalesced;		/**< queued frames never sent, skipped by the consumer or taken back by the producer, written under lock */
+    uint32_t dropped;		/**< submitted frames dropped by the producer, written by the producer */
+} ssd1306_frame_pool_t;
+
+static inline uint32_t ssd1306_queue_load(const uint32_t *v) {
+    return __atomic_load_n(v, __ATOMIC_ACQUIRE);
+}
+
+static inline void ssd1306_queue_store(uint32_t *v, uint32_t val) {
+    __atomic_store_n(v, val, __ATOMIC_RELEASE);
+}
+
+static inline void ssd1306_queue_lock(ssd1306_queue_lock_t *l, int side) {
+    __atomic_store_n(&l->wants[side], 1, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&l->turn, (uint32_t) side, __ATOMIC_SEQ_CST);
+    while(__atomic_load_n(&l->wants[!side], __ATOMIC_SEQ_CST) && __atomic_load_n(&l->turn, __ATOMIC_SEQ_CST)==(uint32_t) side)
+        SSD1306_QUEUE_IDLE();
+}
+
+static inline void ssd1306_queue_unlock(ssd1306_queue_lock_t *l, int side) {
+    __atomic_store_n(&l->wants[side], 0, __ATOMIC_RELEASE);
+}
+
+static inline void ssd1306_queue_init(ssd1306_queue_t *q) {
+    q->head=0;
+    q->tail=0;
+}
+
+/**
+*	@brief number of indices in the queue
+*/
+static inline uint32_t ssd1306_queue_size(ssd1306_queue_t *q) {
+    return ssd1306_queue_load(&q->head)-ssd1306_queue_load(&q->tail);
+}
+
+/**
+*	@brief append index, called by the producer only
+*
+*	@return false if the queue is full
+*/
+static inline bool ssd1306_queue_push(ssd1306_queue_t *q, uint8_t index) {
+    const uint32_t head=__atomic_load_n(&q->head, __ATOMIC_RELAXED);
+
+    if(head-ssd1306_queue_load(&q->tail)==SSD1306_QUEUE_FRAMES)
+        return false;
+
+    q->slots[head%SSD1306_QUEUE_FRAMES]=index;
+    // publishes the slot
+    ssd1306_queue_store(&q->head, head+1);
+    return true;
+}
+
+/**
+*	@brief remove the oldest index, called by the consumer only
+*
+*	@return false if the queue is empty
+*/
+static inline bool ssd1306_queue_pop(ssd1306_queue_t *q, uint8_t *index) {
+    const uint32_t tail=__atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+
+    if(ssd1306_queue_load(&q->head)==tail)
+        return false;
+
+    *index=q->slots[tail%SSD1306_QUEUE_FRAMES];
+    // hands the slot back to the producer
+    ssd1306_queue_store(&q->tail, tail+1);
+    return true;
+}
+
+/**
+*	@brief set up pool, the producer owns the first frame afterwards
+*
+*	@param[in] pool : pool
+*	@param[in] frames : first frame, the others follow every stride bytes
+*	@param[in] stride : distance between frames in bytes
+*	@param[in] count : number of frames, 2 (3 for SSD1306_QUEUE_LATEST) to SSD1306_QUEUE_FRAMES
+*	@param[in] policy : behaviour when the consumer falls behind
+*
+*	@return false if count is out of range
+*/
+static inline bool ssd1306_frame_pool_init(ssd1306_frame_pool_t *pool, uint8_t *frames, size_t stride, size_t count,
+        ssd1306_queue_policy_t policy) {
+    // with SSD1306_QUEUE_LATEST a third frame guarantees that a frame is free or queued while the
+    // producer draws one and the consumer sends another
+    if(count<(policy==SSD1306_QUEUE_LATEST ? 3u : 2u) || count>SSD1306_QUEUE_FRAMES)
+        return false;
+
+    pool->count=(uint8_t) count;
+    pool->current=0;
+    pool->policy=policy;
+    pool->presented=0;
+    pool->coalesced=0;
+    pool->dropped=0;
+    pool->lock.wants[0]=0;
+    pool->lock.wants[1]=0;
+    pool->lock.turn=0;
+    ssd1306_queue_init(&pool->ready);
+    ssd1306_queue_init(&pool->free);
+
+    for(size_t i=0; i<count; ++i) {
+        pool->frames[i]=frames+i*stride;
+        if(i)
+            ssd1306_queue_push(&pool->free, (uint8_t) i);
+    }
+
+    return true;
+}
+
+/**
+*	@brief frame the producer draws into
+*/
+static inline uint8_t *ssd1306_frame_pool_current(ssd1306_frame_pool_t *pool) {
+    return pool->frames[pool->current];
+}
+
+/**
+*	@brief queue the current frame and take a free one, called by the producer only
+*
+*	The returned frame holds an older frame and has to be redrawn completely.
+*	If the frame was dropped, the same frame is returned. With
+*	SSD1306_QUEUE_LATEST the frame is always queued, if no frame is free
+*	the oldest queued frame is taken back instead.
+*
+*	@return frame to draw the next frame into
+*/
+static inline uint8_t *ssd1306_frame_pool_submit(ssd1306_frame_pool_t *pool) {
+    uint8_t next;
+
+    // the free queue is written by the consumer, the producer only pops from it
+    while(!ssd1306_queue_pop(&pool->free, &next)) {
+        if(pool->policy==SSD1306_QUEUE_DROP) {
+            ssd1306_queue_store(&pool->dropped, pool->dropped+1);
+            return ssd1306_frame_pool_current(pool);
+        }
+        if(pool->policy==SSD1306_QUEUE_LATEST) {
+            ssd1306_queue_lock(&pool->lock, 0);
+            const bool taken=ssd1306_queue_pop(&pool->ready, &next);
+            if(taken)
+                ssd1306_queue_store(&pool->coalesced, pool->coalesced+1);
+            ssd1306_queue_unlock(&pool->lock, 0);
+            // the consumer emptied the queue in between, so it has handed frames back
+            if(taken)
+                break;
+        }
+        SSD1306_QUEUE_IDLE();
+    }
+
+    ssd1306_queue_push(&pool->ready, pool->current);
+    pool->current=next;
+    return ssd1306_frame_pool_current(pool);
+}
+
+/**
+*	@brief take the next frame to present, called by the consumer only
+*
+*	@return index of the frame or -1 if no frame is queued
+*/
+static inline int ssd1306_frame_pool_take(ssd1306_frame_pool_t *pool) {
+    uint8_t index, newer;
+
+    if(pool->policy!=SSD1306_QUEUE_LATEST)
+        return ssd1306_queue_pop(&pool->ready, &index) ? index : -1;
+
+    // the producer may take back queued frames as well
+    ssd1306_queue_lock(&pool->lock, 1);
+    if(!ssd1306_queue_pop(&pool->ready, &index)) {
+        ssd1306_queue_unlock(&pool->lock, 1);
+        return -1;
+    }
+    while(ssd1306_queue_pop(&pool->ready, &newer)) {
+        ssd1306_queue_push(&pool->free, index);
+        ssd1306_queue_store(&pool->coalesced, pool->coalesced+1);
+        index=newer;
+    }
+    ssd1306_queue_unlock(&pool->lock, 1);
+
+    return index;
+}
+
+/**
+*	@brief hand a presented frame back to the producer, called by the consumer only
+*/
+static inline void ssd1306_frame_pool_release(ssd1306_frame_pool_t *pool, int index) {
+    ssd1306_queue_store(&pool->presented, pool->presented+1);
+    ssd1306_queue_push(&pool->free, (uint8_t) index);
+}
+#endif
@@ -0,0 +1,693 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+
+/*
+ * compiles a BDF or PCF bitmap font into an ssd1306_font_t for ssd1306_draw_text
+ *
+ * every glyph is written in the column layout of the display buffer, (height+7)/8 bytes per
+ * column and the top row in bit 0, so the draw path copies it without any transformation.
+ * code points are taken as unicode, which holds for ISO10646-1 and ISO8859-1 fonts.
+ */
+
+#define MAX_CODEPOINT 0x10ffff
+#define MAX_DENSE 255
+
+// PCF table types and format bits
+#define PCF_METRICS (1<<2)
+#define PCF_BITMAPS (1<<3)
+#define PCF_BDF_ENCODINGS (1<<5)
+#define PCF_COMPRESSED_METRICS 0x100
+#define PCF_FORMAT_MASK 0xffffff00
+#define PCF_GLYPH_PAD(f) (1u<<((f)&3))
+#define PCF_BYTE_MSB(f) (((f)>>2)&1)
+#define PCF_BIT_MSB(f) (((f)>>3)&1)
+#define PCF_SCAN_UNIT(f) (1u<<(((f)>>4)&3))
+
+// glyph as read from the font, rows of (w+7)/8 bytes with the leftmost pixel in the msb
+typedef struct {
+    uint32_t codepoint;
+    int32_t x, y; // offset of the bottom left pixel from the origin, y grows upwards
+    uint32_t w, h;
+    int32_t advance;
+    uint8_t *rows;
+} glyph_t;
+
+typedef struct {
+    glyph_t *glyphs;
+    size_t count, cap;
+} font_t;
+
+// glyph in the output layout
+typedef struct {
+    uint32_t codepoint;
+    uint32_t offset, width, advance;
+    uint8_t *columns;
+    int duplicate;
+} out_glyph_t;
+
+uint8_t *read_file(FILE *in, size_t *size) {
+    size_t cap=4096;
+    uint8_t *data=malloc(cap);
+
+    *size=0;
+    for(size_t n; data!=NULL && (n=fread(data+*size, 1, cap-*size-1, in))>0;) {
+        *size+=n;
+        if(*size+1==cap) {
+            uint8_t *grown=realloc(data, cap*=2);
+            if(grown==NULL)
+                free(data);
+            data=grown;
+        }
+    }
+
+    // text parsers rely on the terminating zero
+    if(data!=NULL)
+        data[*size]=0;
+    return data;
+}
+
+glyph_t *add_glyph(font_t *f) {
+    if(f->count==f->cap) {
+        glyph_t *grown=realloc(f->glyphs, (f->cap=f->cap?f->cap*2:256)*sizeof(glyph_t));
+        if(grown==NULL)
+            return NULL;
+        f->glyphs=grown;
+    }
+    glyph_t *g=&f->glyphs[f->count++];
+    memset(g, 0, sizeof(*g));
+    return g;
+}
+
+void free_font(font_t *f) {
+    for(size_t i=0; i<f->count; ++i)
+        free(f->glyphs[i].rows);
+    free(f->glyphs);
+}
+
+int hex_digit(char c) {
+    return isdigit((unsigned char) c) ? c-'0' : tolower((unsigned char) c)-'a'+10;
+}
+
+// reads the glyphs between STARTCHAR and ENDCHAR, unencoded glyphs are dropped
+int parse_bdf(char *text, font_t *f) {
+    glyph_t *g=NULL;
+    int in_bitmap=0, have_bbx=0;
+    uint32_t row=0;
+    long encoding=-1;
+
+    for(char *line=strtok(text, "\r\n"); line!=NULL; line=strtok(NULL, "\r\n")) {
+        if(in_bitmap&&strncmp(line, "ENDCHAR", 7)!=0) {
+            const uint32_t stride=(g->w+7)/8;
+            if(row>=g->h) {
+                fprintf(stderr, "glyph %ld has more rows than its BBX!\n", encoding);
+                return 0;
+            }
+            for(uint32_t i=0; i<stride&&isxdigit((unsigned char) line[2*i])&&isxdigit((unsigned char) line[2*i+1]); ++i)
+                g->rows[row*stride+i]=(uint8_t) (hex_digit(line[2*i])<<4|hex_digit(line[2*i+1]));
+            ++row;
+        } else if(strncmp(line, "STARTCHAR", 9)==0) {
+            if(g!=NULL)
+                break;
+            if((g=add_glyph(f))==NULL)
+                return 0;
+            encoding=-1;
+            have_bbx=0;
+        } else if(g==NULL) {
+            continue;
+        } else if(strncmp(line, "ENCODING", 8)==0) {
+            encoding=strtol(line+8, NULL, 10);
+        } else if(strncmp(line, "DWIDTH", 6)==0) {
+            g->advance=strtol(line+6, NULL, 10);
+        } else if(strncmp(line, "BBX", 3)==0) {
+            int w, h;
+            if(sscanf(line+3, "%d %d %d %d", &w, &h, &g->x, &g->y)!=4||w<0||h<0) {
+                fprintf(stderr, "invalid BBX \"%s\"!\n", line);
+                return 0;
+            }
+            g->w=w;
+            g->h=h;
+            have_bbx=1;
+        } else if(strncmp(line, "BITMAP", 6)==0) {
+            if(!have_bbx) {
+                fprintf(stderr, "glyph %ld has no BBX!\n", encoding);
+                return 0;
+            }
+            if(g->rows!=NULL||(g->rows=calloc((size_t) g->h*((g->w+7)/8)+1, 1))==NULL)
+                return 0;
+            in_bitmap=1;
+            row=0;
+        } else if(strncmp(line, "ENDCHAR", 7)==0) {
+            in_bitmap=0;
+            if(g->rows==NULL)
+                g->w=g->h=0;
+            if(encoding<0||encoding>MAX_CODEPOINT) {
+                free(g->rows);
+                --f->count;
+            } else
+                g->codepoint=encoding;
+            g=NULL;
+        }
+    }
+
+    if(g!=NULL) {
+        fprintf(stderr, "glyph %ld lacks its ENDCHAR!\n", encoding);
+        return 0;
+    }
+    return 1;
+}
+
+uint32_t pcf_u32(const uint8_t *d, int msb) {
+    return msb ? (uint32_t) d[0]<<24|d[1]<<16|d[2]<<8|d[3] : (uint32_t) d[3]<<24|d[2]<<16|d[1]<<8|d[0];
+}
+
+int16_t pcf_i16(const uint8_t *d, int msb) {
+    return (int16_t) (msb ? d[0]<<8|d[1] : d[1]<<8|d[0]);
+}
+
+// finds a table in the table of contents, returns its data behind the format word
+const uint8_t *pcf_table(const uint8_t *file, size_t size, uint32_t type, uint32_t *format, size_t *len) {
+    const uint32_t tables=pcf_u32(file+4, 0);
+
+    for(uint32_t i=0; i<tables&&8+16*(i+1)<=size; ++i) {
+        const uint8_t *entry=file+8+16*i;
+        const uint32_t table_size=pcf_u32(entry+8, 0), offset=pcf_u32(entry+12, 0);
+
+        if(pcf_u32(entry, 0)!=type)
+            continue;
+        if(table_size<4||offset>size||size-offset<table_size)
+            return NULL;
+
+        *format=pcf_u32(file+offset, 0);
+        *len=table_size-4;
+        return file+offset+4;
+    }
+
+    return NULL;
+}
+
+// reads metrics, bitmaps and encodings, all other tables are of no use here
+int parse_pcf(const uint8_t *file, size_t size, font_t *f) {
+    uint32_t mf, bf, ef;
+    size_t ml, bl, el;
+    const uint8_t *metrics=pcf_table(file, size, PCF_METRICS, &mf, &ml);
+    const uint8_t *bitmaps=pcf_table(file, size, PCF_BITMAPS, &bf, &bl);
+    const uint8_t *encodings=pcf_table(file, size, PCF_BDF_ENCODINGS, &ef, &el);
+
+    if(metrics==NULL||bitmaps==NULL||encodings==NULL) {
+        fprintf(stderr, "PCF font lacks metrics, bitmaps or encodings!\n");
+        return 0;
+    }
+
+    if(ml<4||bl<4) {
+        fprintf(stderr, "PCF tables are truncated!\n");
+        return 0;
+    }
+
+    const int compressed=(mf&PCF_FORMAT_MASK)==PCF_COMPRESSED_METRICS;
+    const uint32_t count=compressed ? (uint16_t) pcf_i16(metrics, PCF_BYTE_MSB(mf)) : pcf_u32(metrics, PCF_BYTE_MSB(mf));
+    const size_t metrics_size=compressed ? 2+5*(size_t) count : 4+12*(size_t) count;
+
+    if(ml<metrics_size||bl<4+4*(size_t) count+16||pcf_u32(bitmaps, PCF_BYTE_MSB(bf))!=count||el<10) {
+        fprintf(stderr, "PCF tables are truncated!\n");
+        return 0;
+    }
+
+    const uint32_t bitmap_size=pcf_u32(bitmaps+4+4*count+4*(bf&3), PCF_BYTE_MSB(bf));
+    const uint8_t *data=bitmaps+4+4*count+16;
+    if(bl-(4+4*count+16)<bitmap_size) {
+        fprintf(stderr, "PCF bitmaps are truncated!\n");
+        return 0;
+    }
+
+    const int emsb=PCF_BYTE_MSB(ef);
+    const int32_t min2=pcf_i16(encodings, emsb), max2=pcf_i16(encodings+2, emsb);
+    const int32_t min1=pcf_i16(encodings+4, emsb), max1=pcf_i16(encodings+6, emsb);
+    if(min2<0||min1<0||min2>max2||min1>max1||el<10+2*(size_t) (max2-min2+1)*(max1-min1+1)) {
+        fprintf(stderr, "PCF encodings are invalid!\n");
+        return 0;
+    }
+
+    for(int32_t b1=min1; b1<=max1; ++b1) {
+        for(int32_t b2=min2; b2<=max2; ++b2) {
+            const uint16_t index=pcf_i16(encodings+10+2*((b1-min1)*(max2-min2+1)+(b2-min2)), emsb);
+            if(index==0xffff||index>=count)
+                continue;
+
+            int32_t lsb, rsb, advance, ascent, descent;
+            if(compressed) {
+                const uint8_t *m=metrics+2+5*index;
+                lsb=m[0]-0x80;
+                rsb=m[1]-0x80;
+                advance=m[2]-0x80;
+                ascent=m[3]-0x80;
+                descent=m[4]-0x80;
+            } else {
+                const uint8_t *m=metrics+4+12*index;
+                const int msb=PCF_BYTE_MSB(mf);
+                lsb=pcf_i16(m, msb);
+                rsb=pcf_i16(m+2, msb);
+                advance=pcf_i16(m+4, msb);
+                ascent=pcf_i16(m+6, msb);
+                descent=pcf_i16(m+8, msb);
+            }
+            if(rsb<lsb||ascent+descent<0) {
+                fprintf(stderr, "glyph %u has invalid metrics!\n", index);
+                return 0;
+            }
+
+            glyph_t *g=add_glyph(f);
+            if(g==NULL)
+                return 0;
+            g->codepoint=(uint32_t) b1<<8|b2;
+            g->x=lsb;
+            g->y=-descent;
+            g->w=rsb-lsb;
+            g->h=ascent+descent;
+            g->advance=advance;
+
+            const uint32_t stride=(g->w+7)/8, pad=PCF_GLYPH_PAD(bf), unit=PCF_SCAN_UNIT(bf);
+            const uint32_t padded=(stride+pad-1)/pad*pad, offset=pcf_u32(bitmaps+4+4*index, PCF_BYTE_MSB(bf));
+            if(offset>bitmap_size||bitmap_size-offset<(size_t) padded*g->h) {
+                fprintf(stderr, "glyph %u lies outside of the bitmaps!\n", index);
+                return 0;
+            }
+            if((g->rows=calloc((size_t) g->h*stride+1, 1))==NULL)
+                return 0;
+
+            for(uint32_t y=0; y<g->h; ++y) {
+                for(uint32_t i=0; i<stride; ++i) {
+                    // bytes of a scan unit are swapped if byte and bit order differ
+                    uint32_t src=y*padded+i;
+                    if(PCF_BYTE_MSB(bf)!=PCF_BIT_MSB(bf)&&unit>1&&unit<=pad)
+                        src=(src&~(unit-1))|(unit-1-(src&(unit-1)));
+
+                    uint8_t b=data[offset+src];
+                    if(!PCF_BIT_MSB(bf)) {
+                        b=(b&0xf0)>>4|(b&0x0f)<<4;
+                        b=(b&0xcc)>>2|(b&0x33)<<2;
+                        b=(b&0xaa)>>1|(b&0x55)<<1;
+                    }
+                    g->rows[y*stride+i]=b;
+                }
+            }
+        }
+    }
+
+    return 1;
+}
+
+// decodes the utf-8 sequence at *s, 0 for malformed sequences
+uint32_t utf8_next(const char **s) {
+    const uint8_t *u=(const uint8_t *) *s;
+    uint32_t c=u[0], len=c<0x80 ? 1 : c>=0xc2&&c<0xe0 ? 2 : c>=0xe0&&c<0xf0 ? 3 : c>=0xf0&&c<0xf5 ? 4 : 0;
+
+    if(len==0) {
+        *s+=1;
+        return 0;
+    }
+    if(len==1) {
+        *s+=1;
+        return c;
+    }
+
+    c&=0x7f>>len;
+    for(uint32_t i=1; i<len; ++i) {
+        if((u[i]&0xc0)!=0x80) {
+            *s+=i;
+            return 0;
+        }
+        c=c<<6|(u[i]&0x3f);
+    }
+    *s+=len;
+    return c>MAX_CODEPOINT ? 0 : c;
+}
+
+// marks the characters of s, control characters like line breaks are left out
+void select_chars(uint8_t *wanted, const char *s) {
+    while(*s) {
+        const uint32_t c=utf8_next(&s);
+        if(c>=0x20)
+            wanted[c]=1;
+    }
+}
+
+int select_range(uint8_t *wanted, const char *range) {
+    char *end;
+    const unsigned long first=strtoul(range, &end, 0);
+    const unsigned long last=*end=='-' ? strtoul(end+1, &end, 0) : first;
+
+    if(*end!=0||first>last||last>MAX_CODEPOINT)
+        return 0;
+    memset(wanted+first, 1, last-first+1);
+    return 1;
+}
+
+int compare_codepoint(const void *a, const void *b) {
+    const glyph_t *x=a, *y=b;
+    return (x->codepoint>y->codepoint)-(x->codepoint<y->codepoint);
+}
+
+// turns the rows of g into columns below the ascent of the font, trailing empty columns are dropped
+int rotate_glyph(const glyph_t *g, int32_t ascent, uint32_t pages, out_glyph_t *o) {
+    // bitmap fonts rarely reach left of the origin, those glyphs are moved right
+    const int32_t shift=g->x<0 ? -g->x : 0;
+    const uint32_t stride=(g->w+7)/8, columns=g->x+shift+g->w;
+
+    o->codepoint=g->codepoint;
+    o->advance=g->advance+shift;
+    o->width=0;
+    if(g->advance<0||o->advance>255||columns>255) {
+        fprintf(stderr, "glyph U+%04X is too wide!\n", g->codepoint);
+        return 0;
+    }
+    if((o->columns=calloc((size_t) (columns?columns:1)*pages, 1))==NULL)
+        return 0;
+
+    for(uint32_t y=0; y<g->h; ++y) {
+        // row in the font, the top row of the tallest glyph is 0
+        const uint32_t row=ascent-(g->y+(int32_t) g->h)+y;
+        for(uint32_t x=0; x<g->w; ++x) {
+            if(!(g->rows[y*stride+x/8]&(0x80>>(x&7))))
+                continue;
+            const uint32_t col=g->x+shift+x;
+            o->columns[col*pages+row/8]|=1<<(row&7);
+            if(col+1>o->width)
+                o->width=col+1;
+        }
+    }
+
+    return 1;
+}
+
+// fnv-1a
+uint32_t hash_columns(const uint8_t *columns, size_t size) {
+    uint32_t h=2166136261u;
+    for(size_t i=0; i<size; ++i)
+        h=(h^columns[i])*16777619u;
+    return h;
+}
+
+void write_char_comment(uint32_t c, FILE *out) {
+    if(c=='\\'||c=='\'')
+        fprintf(out, " // '\\%c'\n", c);
+    else if(c>=32&&c<127)
+        fprintf(out, " // '%c'\n", c);
+    else
+        fprintf(out, " // U+%04X\n", c);
+}
+
+// dense range in 0..255 that saves the most, each glyph in it saves its 4 byte code point and
+// each hole in it costs a 4 byte glyph entry
+void choose_dense(const out_glyph_t *glyphs, size_t count, uint32_t *first, uint32_t *last) {
+    uint8_t present[MAX_DENSE+1]= {0};
+    long best=0;
+
+    for(size_t i=0; i<count&&glyphs[i].codepoint<=MAX_DENSE; ++i)
+        present[glyphs[i].codepoint]=1;
+
+    *first=1;
+    *last=0;
+    for(uint32_t a=0; a<=MAX_DENSE; ++a) {
+        if(!present[a])
+            continue;
+        long gain=0;
+        for(uint32_t b=a; b<=MAX_DENSE; ++b) {
+            gain+=present[b] ? 4 : -4;
+            if(present[b]&&gain>best) {
+                best=gain;
+                *first=a;
+                *last=b;
+            }
+        }
+    }
+}
+
+void write_glyph_entry(const out_glyph_t *g, FILE *out) {
+    fprintf(out, "\t{%u, %u, %u},", g->offset, g->width, g->advance);
+    write_char_comment(g->codepoint, out);
+}
+
+int main(int ac, char *as[]) {
+    const char *name=NULL;
+    uint8_t *wanted=NULL;
+    int subset=0;
+
+    if((wanted=calloc(MAX_CODEPOINT+1, 1))==NULL)
+        return EXIT_FAILURE;
+
+    for(; ac>2&&as[1][0]=='-'; ac-=2, as+=2) {
+        if(strcmp(as[1], "-n")==0) {
+            name=as[2];
+            continue;
+        } else if(strcmp(as[1], "-c")==0)
+            select_chars(wanted, as[2]);
+        else if(strcmp(as[1], "-r")==0&&select_range(wanted, as[2]))
+            ;
+        else if(strcmp(as[1], "-f")==0) {
+            FILE *chars=fopen(as[2], "rb");
+            size_t size;
+            char *text=chars ? (char *) read_file(chars, &size) : NULL;
+            if(chars)
+                fclose(chars);
+            if(text==NULL) {
+                fprintf(stderr, "Could not read \"%s\"!\n", as[2]);
+                free(wanted);
+                return EXIT_FAILURE;
+            }
+            select_chars(wanted, text);
+            free(text);
+        } else
+            break;
+        subset=1;
+    }
+
+    if(ac<2||ac>3||as[1][0]=='-') {
+        fprintf(stderr, "Usage: %s [-c chars] [-f file] [-r first-last] [-n name] [input file] [output file?]\n", as[0]);
+        fprintf(stderr, "  compiles a BDF or PCF font into an ssd1306_font_t, all glyphs unless a subset is given\n");
+        fprintf(stderr, "  -c  characters to keep, utf-8\n");
+        fprintf(stderr, "  -f  keep the characters of a utf-8 text file, e.g. the strings of a user interface\n");
+        fprintf(stderr, "  -r  code points to keep, e.g. 0x20-0x7e\n");
+        fprintf(stderr, "  -n  name of the font, default is the name of the output file or else the input file\n");
+        free(wanted);
+        return EXIT_FAILURE;
+    }
+
+    FILE *in=NULL, *out=NULL;
+    uint8_t *file=NULL;
+    size_t file_size=0, count=0;
+    font_t font= {0};
+    out_glyph_t *glyphs=NULL;
+    uint8_t *bitmap=NULL;
+    size_t *unique=NULL;
+    char default_name[128];
+    int ok=0;
+
+    if((in=fopen(as[1], "rb"))==NULL) {
+        fprintf(stderr, "Could not open \"%s\" for reading!\n", as[1]);
+        goto done;
+    }
+    if((file=read_file(in, &file_size))==NULL)
+        goto done;
+
+    const int pcf=file_size>=8&&memcmp(file, "\1fcp", 4)==0;
+    if(!pcf&&strncmp((char *) file, "STARTFONT", 9)!=0) {
+        fprintf(stderr, "\"%s\" is neither a BDF nor a PCF font!\n", as[1]);
+        goto done;
+    }
+    if(!(pcf ? parse_pcf(file, file_size, &font) : parse_bdf((char *) file, &font))) {
+        fprintf(stderr, "Could not read a font from \"%s\"!\n", as[1]);
+        goto done;
+    }
+
+    // keep the requested glyphs, the last one of a code point wins
+    if(font.count)
+        qsort(font.glyphs, font.count, sizeof(glyph_t), compare_codepoint);
+    size_t kept=0;
+    for(size_t i=0; i<font.count; ++i) {
+        if(subset&&!wanted[font.glyphs[i].codepoint]) {
+            free(font.glyphs[i].rows);
+            continue;
+        }
+        if(kept>0&&font.glyphs[kept-1].codepoint==font.glyphs[i].codepoint)
+            free(font.glyphs[--kept].rows);
+        font.glyphs[kept++]=font.glyphs[i];
+        wanted[font.glyphs[i].codepoint]=2;
+    }
+    font.count=kept;
+
+    if(subset)
+        for(uint32_t c=0; c<=MAX_CODEPOINT; ++c)
+            if(wanted[c]==1)
+                fprintf(stderr, "warning: the font has no glyph for U+%04X\n", c);
+
+    if(font.count==0) {
+        fprintf(stderr, "no glyphs left!\n");
+        goto done;
+    }
+    if(font.count>0xffff) {
+        fprintf(stderr, "too many glyphs!\n");
+        goto done;
+    }
+
+    // the cell spans the highest ascent and the lowest descent of the kept glyphs
+    int32_t ascent=0, descent=0;
+    for(size_t i=0; i<font.count; ++i) {
+        const glyph_t *g=&font.glyphs[i];
+        if(g->h==0)
+            continue;
+        if(g->y+(int32_t) g->h>ascent)
+            ascent=g->y+g->h;
+        if(-g->y>descent)
+            descent=-g->y;
+    }
+    const uint32_t height=ascent+descent ? ascent+descent : 1;
+    if(height>255) {
+        fprintf(stderr, "the font is %u rows high, at most 255 are supported!\n", height);
+        goto done;
+    }
+    const uint32_t pages=(height+7)/8;
+
+    if((glyphs=calloc(font.count, sizeof(out_glyph_t)))==NULL)
+        goto done;
+    for(; count<font.count; ++count)
+        if(!rotate_glyph(&font.glyphs[count], ascent, pages, &glyphs[count]))
+            goto done;
+
+    // identical glyphs share their columns, found through a hash table of the unique glyphs
+    size_t bitmap_size=0, duplicates=0, saved=0, raw_size=0, buckets=1;
+    for(size_t i=0; i<count; ++i)
+        raw_size+=(size_t) glyphs[i].width*pages;
+    while(buckets<2*count)
+        buckets<<=1;
+    if((bitmap=malloc(raw_size+1))==NULL||(unique=malloc(buckets*sizeof(size_t)))==NULL)
+        goto done;
+    memset(unique, 0xff, buckets*sizeof(size_t));
+
+    for(size_t i=0; i<count; ++i) {
+        out_glyph_t *g=&glyphs[i];
+        const size_t size=(size_t) g->width*pages;
+
+        g->offset=bitmap_size;
+        if(size==0)
+            continue;
+
+        size_t b=hash_columns(g->columns, size)&(buckets-1);
+        for(; unique[b]!=SIZE_MAX; b=(b+1)&(buckets-1)) {
+            const out_glyph_t *u=&glyphs[unique[b]];
+            if(u->width==g->width&&memcmp(u->columns, g->columns, size)==0)
+                break;
+        }
+
+        if(unique[b]!=SIZE_MAX) {
+            g->offset=glyphs[unique[b]].offset;
+            g->duplicate=1;
+            ++duplicates;
+            saved+=size;
+        } else {
+            unique[b]=i;
+            memcpy(bitmap+bitmap_size, g->columns, size);
+            bitmap_size+=size;
+        }
+    }
+    if(bitmap_size>0xffff) {
+        fprintf(stderr, "%lu bitmap bytes are too many for 16 bit glyph offsets, keep fewer glyphs with -c, -f or -r!\n", bitmap_size);
+        goto done;
+    }
+
+    uint32_t first, last;
+    choose_dense(glyphs, count, &first, &last);
+    const uint32_t dense=first<=last ? last-first+1 : 0;
+    size_t sparse=0;
+    for(size_t i=0; i<count; ++i)
+        sparse+=glyphs[i].codepoint<first||glyphs[i].codepoint>last;
+
+    if(ac==3) {
+        if((out=fopen(as[2], "w"))==NULL) {
+            fprintf(stderr, "Could not open \"%s\" for writing!\n", as[2]);
+            goto done;
+        }
+    } else
+        out=stdout;
+
+    if(name==NULL) {
+        const char *base=ac==3 ? as[2] : as[1], *slash=strrchr(base, '/');
+        size_t i=0;
+        for(base=slash?slash+1:base; base[i]&&base[i]!='.'&&i+1<sizeof(default_name); ++i)
+            default_name[i]=isalnum((unsigned char) base[i]) ? base[i] : '_';
+        default_name[i]=0;
+        name=default_name;
+    }
+
+    fprintf(out, "#ifndef _%s_h\n#define _%s_h\n#include <stdint.h>\n#include \"font_struct.h\"\n\n", name, name);
+    fprintf(out, "// generated by tools/bdf2c from %s\n", as[1]);
+    fprintf(out, "static const uint8_t %s_bitmap[]= {\n", name);
+    for(size_t i=0; i<count; ++i) {
+        if(glyphs[i].duplicate||glyphs[i].width==0)
+            continue;
+        fprintf(out, "\t");
+        for(size_t b=0; b<(size_t) glyphs[i].width*pages; ++b)
+            fprintf(out, "0x%02x,", glyphs[i].columns[b]);
+        write_char_comment(glyphs[i].codepoint, out);
+    }
+    fprintf(out, "};\n\n");
+
+    // the dense range first, holes get empty glyphs, then the sparse glyphs
+    fprintf(out, "static const ssd1306_glyph_t %s_glyphs[]= {\n", name);
+    for(uint32_t c=first, i=0; c<=last; ++c) {
+        while(i<count&&glyphs[i].codepoint<c)
+            ++i;
+        if(i<count&&glyphs[i].codepoint==c)
+            write_glyph_entry(&glyphs[i], out);
+        else {
+            fprintf(out, "\t{0, 0, 0},");
+            write_char_comment(c, out);
+        }
+    }
+    for(size_t i=0; i<count; ++i)
+        if(glyphs[i].codepoint<first||glyphs[i].codepoint>last)
+            write_glyph_entry(&glyphs[i], out);
+    fprintf(out, "};\n\n");
+
+    if(sparse) {
+        fprintf(out, "static const uint32_t %s_codepoints[]= {\n", name);
+        for(size_t i=0; i<count; ++i)
+            if(glyphs[i].codepoint<first||glyphs[i].codepoint>last)
+                fprintf(out, "\t0x%04x,\n", glyphs[i].codepoint);
+        fprintf(out, "};\n\n");
+    }
+
+    fprintf(out, "const ssd1306_font_t %s= {\n", name);
+    fprintf(out, "\t.height=%u,\n\t.first=%u,\n\t.last=%u,\n", height, first, last);
+    fprintf(out, "\t.glyphs=%s_glyphs,\n\t.bitmap=%s_bitmap,\n", name, name);
+    if(sparse)
+        fprintf(out, "\t.codepoints=%s_codepoints,\n\t.sparse=%lu,\n", name, sparse);
+    fprintf(out, "};\n#endif\n");
+
+    fprintf(stderr, "%s: %lu glyphs, %u rows, ", as[1], count, height);
+    if(dense)
+        fprintf(stderr, "dense range %u-%u, %lu sparse\n", first, last, sparse);
+    else
+        fprintf(stderr, "no dense range, %lu sparse\n", sparse);
+    fprintf(stderr, "  bitmap %lu bytes (%lu duplicate glyphs saved %lu of %lu)\n", bitmap_size, duplicates, saved, raw_size);
+    fprintf(stderr, "  glyph table %lu bytes, code points %lu bytes, total %lu bytes\n",
+            (dense+sparse)*4ul, sparse*4ul, bitmap_size+(dense+sparse)*4ul+sparse*4ul);
+    ok=1;
+
+done:
+    for(size_t i=0; i<count; ++i)
+        free(glyphs[i].columns);
+    free(glyphs);
+    free(bitmap);
+    free(unique);
+    free_font(&font);
+    free(file);
+    free(wanted);
+    if(in)
+        fclose(in);
+    if(out&&out!=stdout)
+        fclose(out);
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
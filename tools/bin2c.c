@@ -6,6 +6,11 @@
 
 #define BUFSIZE 256
 
+// header of the page images drawn by ssd1306_draw_image: width, height, format
+#define IMAGE_HEADER_SIZE 3
+#define IMAGE_FORMAT_PAGES 0
+#define IMAGE_FORMAT_RLE 1
+
 void normalize_name(char *name) {
     for(size_t i=0; name[i]!=0;) {
         if('a'<=name[i]&&name[i]<='z')
@@ -21,40 +26,189 @@ next:
     }
 }
 
-void convert_to_char_array(const char *name, FILE *in, FILE *out) {
+// constant arrays stay in flash instead of being copied into ram at startup
+void write_char_array(const char *name, const uint8_t *data, size_t size, int constant, FILE *out) {
+    fprintf(out, "const unsigned long %s_size=%lu;\n", name, size);
+    fprintf(out, "%sunsigned char %s_data[]={\n", constant?"const ":"", name);
+
+    for(size_t i=0; i<size;) {
+        if(i+1<size)
+            fprintf(out, "0x%02x,", data[i]);
+        else
+            fprintf(out, "0x%02x", data[i]);
+        ++i;
+        if((i&15)==0)
+            fprintf(out, "\n");
+    }
+    fprintf(out, "\n};\n");
+}
+
+uint8_t *read_file(FILE *in, size_t *size) {
     fseek(in, 0, SEEK_END);
     size_t file_size=ftell(in);
     fseek(in, 0, SEEK_SET);
 
-    fprintf(out, "const unsigned long %s_size=%lu;\n", name, file_size);
-    uint8_t buf[BUFSIZE];
-    size_t read_bytes, wrote_bytes=0;
-
-    fprintf(out, "unsigned char %s_data[]={\n", name);
+    uint8_t *data=malloc(file_size?file_size:1);
+    if(data==NULL)
+        return NULL;
 
+    size_t read_bytes, total=0;
     do {
-        read_bytes=fread(buf, 1, BUFSIZE, in);
+        read_bytes=fread(data+total, 1, file_size-total<BUFSIZE?file_size-total:BUFSIZE, in);
+        total+=read_bytes;
+    } while(read_bytes>0&&total<file_size);
 
-        for(size_t i=0; i<read_bytes;) {
-            if(++wrote_bytes<file_size)
-                fprintf(out, "0x%02x,", buf[i]);
-            else
-                fprintf(out, "0x%02x", buf[i]);
-            ++i;
-            if(((i&15)==0)&&i>0)
-                fprintf(out, "\n");
+    *size=total;
+    return data;
+}
+
+uint32_t get_val(const uint8_t *data, size_t offset, uint8_t size) {
+    uint32_t val=0;
+    for(uint8_t i=0; i<size; ++i)
+        val|=(uint32_t) data[offset+i]<<(8*i);
+    return val;
+}
+
+/*
+ * converts a monochrome bmp into the page format of the display buffer:
+ * byte [page*width+x] holds the rows page*8 to page*8+7 of column x, top row in bit 0
+ */
+uint8_t *bmp_to_pages(const uint8_t *data, size_t size, size_t *image_size) {
+    if(size<54) {
+        fprintf(stderr, "file too small for a bmp!\n");
+        return NULL;
+    }
+
+    const uint32_t bfOffBits=get_val(data, 10, 4);
+    const uint32_t biSize=get_val(data, 14, 4);
+    const uint32_t biWidth=get_val(data, 18, 4);
+    const int32_t biHeight=(int32_t) get_val(data, 22, 4);
+    const uint16_t biBitCount=(uint16_t) get_val(data, 28, 2);
+    const uint32_t biCompression=get_val(data, 30, 4);
+    const uint32_t height=biHeight<0?-biHeight:biHeight;
+
+    if(biBitCount!=1||biCompression!=0) {
+        fprintf(stderr, "only uncompressed monochrome bmps are supported!\n");
+        return NULL;
+    }
+
+    if(biWidth==0||biWidth>255||height==0||height>255) {
+        fprintf(stderr, "image size %ux%u not supported!\n", biWidth, height);
+        return NULL;
+    }
+
+    uint32_t bytes_per_line=((biWidth+31)/32)*4;
+    const size_t table_start=14+biSize;
+
+    if(table_start+8>size||bfOffBits+(size_t) bytes_per_line*height>size) {
+        fprintf(stderr, "bmp is truncated!\n");
+        return NULL;
+    }
+
+    // pixels with the black color table entry are lit, like in ssd1306_bmp_show_image
+    uint8_t color_val=0;
+    for(uint8_t i=0; i<2; ++i) {
+        if(!((data[table_start+i*4]<<16)|(data[table_start+i*4+1]<<8)|data[table_start+i*4+2])) {
+            color_val=i;
+            break;
         }
-    } while(read_bytes==BUFSIZE);
-    fprintf(out, "\n};\n");
+    }
+
+    const uint32_t pages=(height+7)/8;
+    *image_size=IMAGE_HEADER_SIZE+pages*biWidth;
+
+    uint8_t *image=calloc(*image_size, 1);
+    if(image==NULL)
+        return NULL;
+
+    image[0]=biWidth;
+    image[1]=height;
+    image[2]=IMAGE_FORMAT_PAGES;
+
+    for(uint32_t y=0; y<height; ++y) {
+        // bottom-up bmps store the last row first
+        const uint8_t *line=data+bfOffBits+(size_t) bytes_per_line*(biHeight>0?height-1-y:y);
+        for(uint32_t x=0; x<biWidth; ++x) {
+            if(((line[x>>3]>>(7-(x&7)))&1)==color_val)
+                image[IMAGE_HEADER_SIZE+(y>>3)*biWidth+x]|=1<<(y&7);
+        }
+    }
+
+    return image;
+}
+
+/*
+ * run-length encodes the data of a page image. control bytes below 0x80 are followed by
+ * control+1 literal bytes, others by one byte that is repeated (control&0x7f)+3 times
+ */
+uint8_t *rle_encode(const uint8_t *image, size_t image_size, size_t *rle_size) {
+    const uint8_t *data=image+IMAGE_HEADER_SIZE;
+    const size_t size=image_size-IMAGE_HEADER_SIZE;
+
+    // worst case is one control byte per 128 literals
+    uint8_t *rle=malloc(IMAGE_HEADER_SIZE+size+size/128+1);
+    if(rle==NULL)
+        return NULL;
+
+    memcpy(rle, image, IMAGE_HEADER_SIZE);
+    rle[2]=IMAGE_FORMAT_RLE;
+
+    size_t n=IMAGE_HEADER_SIZE, literal_start=0, i=0;
+
+    while(i<=size) {
+        size_t run=1;
+        while(i+run<size&&data[i+run]==data[i]&&run<130)
+            ++run;
+
+        // flush pending literals before a run and at the end
+        if(i==size||run>=3||i-literal_start==128) {
+            while(literal_start<i) {
+                size_t len=i-literal_start<128?i-literal_start:128;
+                rle[n++]=len-1;
+                memcpy(rle+n, data+literal_start, len);
+                n+=len;
+                literal_start+=len;
+            }
+        }
+
+        if(i==size)
+            break;
+
+        if(run>=3) {
+            rle[n++]=0x80|(run-3);
+            rle[n++]=data[i];
+            i+=run;
+            literal_start=i;
+        } else
+            ++i;
+    }
+
+    *rle_size=n;
+    return rle;
 }
 
 int main(int ac, char *as[]) {
+    int pages=0, rle=0;
+
+    if(ac>1&&strcmp(as[1], "-p")==0) {
+        pages=1;
+        --ac;
+        ++as;
+    } else if(ac>1&&strcmp(as[1], "-r")==0) {
+        pages=rle=1;
+        --ac;
+        ++as;
+    }
+
     if(ac<2||ac>3) {
-        fprintf(stderr, "Usage: %s [input file] [output file?]\n", as[0]);
+        fprintf(stderr, "Usage: %s [-p|-r] [input file] [output file?]\n", as[0]);
+        fprintf(stderr, "  -p  convert a monochrome bmp into a page image for ssd1306_draw_image\n");
+        fprintf(stderr, "  -r  like -p, but run-length encoded\n");
         return EXIT_FAILURE;
     }
 
     FILE *in=NULL, *out=NULL;
+    uint8_t *data=NULL, *image=NULL, *encoded=NULL;
 
     if((in=fopen(as[1], "rb"))==NULL) {
         fprintf(stderr, "Could not open \"%s\" for reading!\n", as[1]);
@@ -69,12 +223,41 @@ int main(int ac, char *as[]) {
     } else
         out=stdout;
 
+    size_t size;
+    if((data=read_file(in, &size))==NULL) {
+        fprintf(stderr, "Could not read \"%s\"!\n", as[1]);
+        goto fail;
+    }
+
     char *norm_name=strdup(as[1]);
     normalize_name(norm_name);
 
-    convert_to_char_array(norm_name, in, out);
+    if(pages) {
+        size_t image_size;
+        if((image=bmp_to_pages(data, size, &image_size))==NULL) {
+            free(norm_name);
+            goto fail;
+        }
+        if(rle) {
+            size_t rle_size;
+            if((encoded=rle_encode(image, image_size, &rle_size))==NULL) {
+                free(norm_name);
+                goto fail;
+            }
+            write_char_array(norm_name, encoded, rle_size, 1, out);
+            fprintf(stderr, "%s: %lu bytes bmp -> %lu bytes page image -> %lu bytes encoded (%.1f%%, ratio %.2f)\n",
+                    as[1], size, image_size, rle_size, 100.0*rle_size/image_size, (double) image_size/rle_size);
+        } else {
+            write_char_array(norm_name, image, image_size, 1, out);
+            fprintf(stderr, "%s: %lu bytes bmp -> %lu bytes page image\n", as[1], size, image_size);
+        }
+    } else
+        write_char_array(norm_name, data, size, 0, out);
 
     free(norm_name);
+    free(encoded);
+    free(image);
+    free(data);
 
     fclose(in);
     fclose(out);
@@ -82,6 +265,9 @@ int main(int ac, char *as[]) {
     return EXIT_SUCCESS;
 
 fail:
+    free(encoded);
+    free(image);
+    free(data);
     if(in)
         fclose(in);
     if(out)
@@ -0,0 +1,346 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <ctype.h>
+
+/*
+ * converts a font of the raw format of font.h into an ssd1306_font_t for ssd1306_draw_text
+ *
+ * raw format: height, width, spacing, first char, last char, then width columns of
+ * (height+7)/8 bytes per char
+ */
+
+#define RAW_HEADER_SIZE 5
+
+typedef struct {
+    char name[128];
+    uint8_t height, width, spacing, first, last;
+    uint8_t *data;
+    size_t size;
+} raw_font_t;
+
+typedef struct {
+    uint16_t left, right;
+    int8_t adjust;
+} kerning_t;
+
+char *read_text(FILE *in) {
+    size_t size=0, cap=4096;
+    char *text=malloc(cap);
+
+    for(size_t n; text!=NULL && (n=fread(text+size, 1, cap-size-1, in))>0;) {
+        size+=n;
+        if(size+1==cap) {
+            char *grown=realloc(text, cap*=2);
+            if(grown==NULL)
+                free(text);
+            text=grown;
+        }
+    }
+
+    if(text!=NULL)
+        text[size]=0;
+    return text;
+}
+
+// reads the first array of the header, comments are skipped
+int parse_font(const char *text, raw_font_t *f) {
+    const char *brackets=strstr(text, "[]"), *s;
+    if(brackets==NULL||(s=strchr(brackets, '{'))==NULL) {
+        fprintf(stderr, "no array found!\n");
+        return 0;
+    }
+
+    const char *name_end=brackets;
+    while(name_end>text&&isspace((unsigned char) name_end[-1]))
+        --name_end;
+    const char *name=name_end;
+    while(name>text&&(isalnum((unsigned char) name[-1])||name[-1]=='_'))
+        --name;
+    if(name==name_end||(size_t) (name_end-name)>=sizeof(f->name)) {
+        fprintf(stderr, "no usable array name!\n");
+        return 0;
+    }
+    memcpy(f->name, name, name_end-name);
+    f->name[name_end-name]=0;
+
+    size_t cap=1024;
+    f->size=0;
+    if((f->data=malloc(cap))==NULL)
+        return 0;
+
+    for(++s; *s&&*s!='}';) {
+        if(s[0]=='/'&&s[1]=='/') {
+            while(*s&&*s!='\n')
+                ++s;
+        } else if(s[0]=='/'&&s[1]=='*') {
+            const char *end=strstr(s+2, "*/");
+            s=end?end+2:s+strlen(s);
+        } else if(isdigit((unsigned char) *s)) {
+            char *end;
+            const long val=strtol(s, &end, 0);
+            if(val<0||val>255) {
+                fprintf(stderr, "value %ld out of range!\n", val);
+                return 0;
+            }
+            if(f->size==cap) {
+                uint8_t *grown=realloc(f->data, cap*=2);
+                if(grown==NULL)
+                    return 0;
+                f->data=grown;
+            }
+            f->data[f->size++]=(uint8_t) val;
+            s=end;
+        } else
+            ++s;
+    }
+
+    if(f->size<RAW_HEADER_SIZE) {
+        fprintf(stderr, "font header missing!\n");
+        return 0;
+    }
+
+    f->height=f->data[0];
+    f->width=f->data[1];
+    f->spacing=f->data[2];
+    f->first=f->data[3];
+    f->last=f->data[4];
+
+    const size_t glyph_size=(size_t) f->width*((f->height+7)/8);
+    if(f->height==0||f->first>f->last||f->size<RAW_HEADER_SIZE+(f->last-f->first+1)*glyph_size) {
+        fprintf(stderr, "font data does not match its header!\n");
+        return 0;
+    }
+
+    return 1;
+}
+
+int compare_kerning(const void *a, const void *b) {
+    const kerning_t *x=a, *y=b;
+    return x->left!=y->left ? x->left-y->left : x->right-y->right;
+}
+
+// reads lines of two characters followed by the adjustment, e.g. "To -1"
+kerning_t *read_kerning(FILE *in, const raw_font_t *f, size_t *count) {
+    char line[256];
+    size_t n=0, cap=64;
+    kerning_t *pairs=malloc(cap*sizeof(*pairs));
+
+    while(pairs!=NULL&&fgets(line, sizeof(line), in)!=NULL) {
+        const uint8_t left=line[0], right=line[1];
+        if(left<f->first||left>f->last||right<f->first||right>f->last)
+            continue;
+
+        if(n==cap) {
+            kerning_t *grown=realloc(pairs, (cap*=2)*sizeof(*pairs));
+            if(grown==NULL)
+                free(pairs);
+            pairs=grown;
+            if(pairs==NULL)
+                break;
+        }
+        pairs[n++]=(kerning_t) {left-f->first, right-f->first, (int8_t) strtol(line+2, NULL, 10)};
+    }
+
+    if(pairs!=NULL)
+        qsort(pairs, n, sizeof(*pairs), compare_kerning);
+    *count=n;
+    return pairs;
+}
+
+void write_char_comment(uint8_t c, FILE *out) {
+    if(c=='\\'||c=='\'')
+        fprintf(out, " // '\\%c'\n", c);
+    else if(c>=32&&c<127)
+        fprintf(out, " // '%c'\n", c);
+    else
+        fprintf(out, " // 0x%02x\n", c);
+}
+
+int column_empty(const uint8_t *column, uint32_t pages) {
+    for(uint32_t i=0; i<pages; ++i)
+        if(column[i])
+            return 0;
+    return 1;
+}
+
+// writes the font, proportional glyphs drop their empty columns on both sides
+int write_font(const raw_font_t *f, const char *name, int proportional, const kerning_t *kerning, size_t kernings, size_t *size, FILE *out) {
+    const uint32_t pages=(f->height+7)/8;
+    const uint32_t glyphs=f->last-f->first+1;
+    uint32_t *first=malloc(glyphs*sizeof(uint32_t)), *width=malloc(glyphs*sizeof(uint32_t)), *left=malloc(glyphs*sizeof(uint32_t));
+    size_t bitmap_size=0;
+
+    if(first==NULL||width==NULL||left==NULL) {
+        free(first);
+        free(width);
+        free(left);
+        return 0;
+    }
+
+    // measure first, the offsets of ssd1306_glyph_t have 16 bits
+    for(uint32_t g=0; g<glyphs; ++g) {
+        const uint8_t *columns=f->data+RAW_HEADER_SIZE+g*f->width*pages;
+        uint32_t x0=0, x1=f->width;
+
+        if(proportional) {
+            while(x0<x1&&column_empty(columns+x0*pages, pages))
+                ++x0;
+            while(x1>x0&&column_empty(columns+(x1-1)*pages, pages))
+                --x1;
+        }
+
+        first[g]=bitmap_size;
+        width[g]=x1-x0;
+        left[g]=x0;
+        bitmap_size+=(x1-x0)*pages;
+    }
+    if(bitmap_size>0xffff) {
+        fprintf(stderr, "%lu bitmap bytes are too many for 16 bit glyph offsets, split the font!\n", bitmap_size);
+        free(first);
+        free(width);
+        free(left);
+        return 0;
+    }
+
+    fprintf(out, "#ifndef _%s_h\n#define _%s_h\n#include <stdint.h>\n#include \"font_struct.h\"\n\n", name, name);
+    fprintf(out, "// generated by tools/fontconv%s from %s\n", proportional?" -p":"", f->name);
+    fprintf(out, "static const uint8_t %s_bitmap[]= {\n", name);
+
+    for(uint32_t g=0; g<glyphs; ++g) {
+        const uint8_t *columns=f->data+RAW_HEADER_SIZE+g*f->width*pages;
+
+        if(width[g]==0)
+            continue;
+
+        fprintf(out, "\t");
+        for(uint32_t i=left[g]*pages; i<(left[g]+width[g])*pages; ++i)
+            fprintf(out, "0x%02x,", columns[i]);
+        write_char_comment(f->first+g, out);
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static const ssd1306_glyph_t %s_glyphs[]= {\n", name);
+    for(uint32_t g=0; g<glyphs; ++g) {
+        // glyphs without pixels keep half the width as advance, so spaces stay visible
+        const uint32_t advance=(width[g]||!proportional ? (proportional?width[g]:f->width) : (f->width+1u)/2)+f->spacing;
+        fprintf(out, "\t{%u, %u, %u},", first[g], width[g], advance);
+        write_char_comment(f->first+g, out);
+    }
+    fprintf(out, "};\n\n");
+
+    if(kernings) {
+        fprintf(out, "static const ssd1306_kerning_t %s_kerning[]= {\n", name);
+        for(size_t i=0; i<kernings; ++i)
+            fprintf(out, "\t{%u, %u, %d}, // '%c%c'\n", kerning[i].left, kerning[i].right, kerning[i].adjust,
+                    f->first+kerning[i].left, f->first+kerning[i].right);
+        fprintf(out, "};\n\n");
+    }
+
+    fprintf(out, "const ssd1306_font_t %s= {\n", name);
+    fprintf(out, "\t.height=%u,\n\t.first=%u,\n\t.last=%u,\n", f->height, f->first, f->last);
+    fprintf(out, "\t.glyphs=%s_glyphs,\n\t.bitmap=%s_bitmap,\n", name, name);
+    if(kernings)
+        fprintf(out, "\t.kerning=%s_kerning,\n\t.kernings=%lu,\n", name, kernings);
+    fprintf(out, "};\n#endif\n");
+
+    free(first);
+    free(width);
+    free(left);
+    *size=bitmap_size;
+    return 1;
+}
+
+int main(int ac, char *as[]) {
+    int proportional=0;
+    const char *name=NULL, *kerning_path=NULL;
+
+    for(; ac>1&&as[1][0]=='-'; --ac, ++as) {
+        if(strcmp(as[1], "-p")==0)
+            proportional=1;
+        else if(strcmp(as[1], "-n")==0&&ac>2) {
+            name=as[2];
+            --ac;
+            ++as;
+        } else if(strcmp(as[1], "-k")==0&&ac>2) {
+            kerning_path=as[2];
+            --ac;
+            ++as;
+        } else
+            break;
+    }
+
+    if(ac<2||ac>3||as[1][0]=='-') {
+        fprintf(stderr, "Usage: %s [-p] [-k kerning file] [-n name] [input file] [output file?]\n", as[0]);
+        fprintf(stderr, "  converts a font header in the raw format of font.h into an ssd1306_font_t\n");
+        fprintf(stderr, "  -p  proportional, glyphs lose their empty columns\n");
+        fprintf(stderr, "  -k  kerning pairs, one per line as two characters and the adjustment, e.g. \"To -1\"\n");
+        fprintf(stderr, "  -n  name of the font, default is the name of the array\n");
+        return EXIT_FAILURE;
+    }
+
+    FILE *in=NULL, *out=NULL;
+    char *text=NULL;
+    raw_font_t font= {0};
+    kerning_t *kerning=NULL;
+    size_t kernings=0;
+
+    if((in=fopen(as[1], "r"))==NULL) {
+        fprintf(stderr, "Could not open \"%s\" for reading!\n", as[1]);
+        goto fail;
+    }
+
+    if((text=read_text(in))==NULL||!parse_font(text, &font)) {
+        fprintf(stderr, "Could not read a font from \"%s\"!\n", as[1]);
+        goto fail;
+    }
+
+    if(kerning_path!=NULL) {
+        FILE *k=fopen(kerning_path, "r");
+        if(k==NULL) {
+            fprintf(stderr, "Could not open \"%s\" for reading!\n", kerning_path);
+            goto fail;
+        }
+        kerning=read_kerning(k, &font, &kernings);
+        fclose(k);
+        if(kerning==NULL)
+            goto fail;
+    }
+
+    if(ac==3) {
+        if((out=fopen(as[2], "w"))==NULL) {
+            fprintf(stderr, "Could not open \"%s\" for writing!\n", as[2]);
+            goto fail;
+        }
+    } else
+        out=stdout;
+
+    const uint32_t glyphs=font.last-font.first+1;
+    const size_t raw_size=glyphs*font.width*((font.height+7)/8);
+    size_t bitmap_size;
+    if(!write_font(&font, name?name:font.name, proportional, kerning, kernings, &bitmap_size, out))
+        goto fail;
+
+    fprintf(stderr, "%s: %u glyphs, %lu -> %lu bitmap bytes, %lu bytes glyph table, %lu kerning pairs\n",
+            as[1], glyphs, raw_size, bitmap_size, glyphs*4ul, kernings);
+
+    free(kerning);
+    free(font.data);
+    free(text);
+    fclose(in);
+    if(out!=stdout)
+        fclose(out);
+
+    return EXIT_SUCCESS;
+
+fail:
+    free(kerning);
+    free(font.data);
+    free(text);
+    if(in)
+        fclose(in);
+    if(out&&out!=stdout)
+        fclose(out);
+    return EXIT_FAILURE;
+}